@@ -0,0 +1,487 @@
+#pragma once
+#include "Vector.hpp"
+#include "zensim/execution/Atomics.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/execution/Intrinsics.hpp"
+#include "zensim/math/Hash.hpp"
+#include "zensim/math/Vec.h"
+#include "zensim/math/bit/Bits.h"
+#include "zensim/memory/MemoryResource.h"
+#include "zensim/resource/Resource.h"
+
+namespace zs {
+
+  /// maps integer keys (or vecs of integers) to trivially-copyable values stored inline next to
+  /// their keys, thus a lookup touches a single slot, e.g. HashMap<vec<i32, 2>, i32> for edges
+  /// the key whose scalars are all limits<>::max() is reserved as the sentinel
+  template <typename Key, typename Value, typename AllocatorT = ZSPmrAllocator<>> struct HashMap {
+    static_assert(is_zs_allocator<AllocatorT>::value,
+                  "HashMap only works with zspmrallocator for now.");
+    static_assert(is_same_v<Key, remove_cvref_t<Key>>, "Key is not cvref-unqualified type!");
+    static_assert(is_same_v<Value, remove_cvref_t<Value>>, "Value is not cvref-unqualified type!");
+    static_assert(std::is_default_constructible_v<Value>, "Value is not default-constructible!");
+    static_assert(std::is_trivially_copyable_v<Key>, "Key is not trivially-copyable!");
+    static_assert(std::is_trivially_copyable_v<Value>, "Value is not trivially-copyable!");
+
+    using key_t = Key;
+    using mapped_t = Value;
+    using index_type = i64;
+    using size_type = std::make_unsigned_t<index_type>;
+    using difference_type = index_type;
+    using status_t = int;
+
+    static constexpr bool key_is_vec_v = is_vec<key_t>::value;
+    static_assert(key_is_vec_v || std::is_integral_v<key_t>,
+                  "Key should either be an integer or a vec of integers!");
+    /// keys of 4 or 8 bytes are claimed by one CAS, others through a per-slot lock
+    static constexpr bool packed_key_v = sizeof(key_t) == 4 || sizeof(key_t) == 8;
+    static_assert(packed_key_v || key_is_vec_v, "integer keys should be of 4 or 8 bytes!");
+    using storage_key_t
+        = conditional_t<packed_key_v, conditional_t<sizeof(key_t) == 4, u32, u64>, key_t>;
+
+    /// values updated by a word-sized CAS need word alignment
+    static constexpr std::size_t value_alignment_v
+        = sizeof(mapped_t) == 4 || sizeof(mapped_t) == 8
+              ? std::max(sizeof(mapped_t), std::alignment_of_v<mapped_t>)
+              : std::alignment_of_v<mapped_t>;
+    struct entry_t {
+      storage_key_t key;
+      alignas(value_alignment_v) mapped_t value;
+    };
+
+    using value_type = entry_t;
+    using allocator_type = AllocatorT;
+
+    static_assert(
+        std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+            && std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value
+            && std::allocator_traits<allocator_type>::propagate_on_container_swap::value,
+        "allocator should propagate on copy, move and swap (for impl simplicity)!");
+
+    static constexpr index_type sentinel_v{-1};
+    static constexpr status_t status_sentinel_v{-1};
+
+    static constexpr storage_key_t pack_key(const key_t &key) noexcept {
+      if constexpr (packed_key_v && key_is_vec_v) {
+        using scalar_t = std::make_unsigned_t<typename key_t::value_type>;
+        constexpr int bits = sizeof(scalar_t) * 8;
+        storage_key_t ret = (storage_key_t)(scalar_t)key[0];
+        for (int d = 1; d != key_t::extent; ++d)
+          ret = (ret << bits) | (storage_key_t)(scalar_t)key[d];
+        return ret;
+      } else if constexpr (packed_key_v)
+        return (storage_key_t)key;
+      else
+        return key;
+    }
+    static constexpr key_t unpack_key(storage_key_t code) noexcept {
+      if constexpr (packed_key_v && key_is_vec_v) {
+        using scalar_t = std::make_unsigned_t<typename key_t::value_type>;
+        constexpr int bits = sizeof(scalar_t) * 8;
+        key_t ret{};
+        for (int d = key_t::extent - 1; d > 0; --d, code >>= bits)
+          ret[d] = (typename key_t::value_type)(scalar_t)code;
+        ret[0] = (typename key_t::value_type)(scalar_t)code;
+        return ret;
+      } else if constexpr (packed_key_v)
+        return (key_t)code;
+      else
+        return code;
+    }
+    static constexpr storage_key_t deduce_storage_key_sentinel() noexcept {
+      if constexpr (key_is_vec_v)
+        return pack_key(key_t::uniform(limits<typename key_t::value_type>::max()));
+      else
+        return pack_key(limits<key_t>::max());
+    }
+    static constexpr storage_key_t storage_key_sentinel_v = deduce_storage_key_sentinel();
+
+    constexpr decltype(auto) memoryLocation() const noexcept { return _allocator.location; }
+    constexpr ProcID devid() const noexcept { return memoryLocation().devid(); }
+    constexpr memsrc_e memspace() const noexcept { return memoryLocation().memspace(); }
+    decltype(auto) get_allocator() const noexcept { return _allocator; }
+    decltype(auto) get_default_allocator(memsrc_e mre, ProcID devid) const {
+      if constexpr (is_virtual_zs_allocator<allocator_type>::value)
+        return get_virtual_memory_source(mre, devid, (std::size_t)1 << (std::size_t)36, "STACK");
+      else
+        return get_memory_source(mre, devid);
+    }
+
+    /// slots are probed linearly, which stays fast up to ~88% load
+    constexpr std::size_t evaluateTableSize(std::size_t entryCnt) const {
+      if (entryCnt == 0) return (std::size_t)0;
+      return std::max(next_2pow(entryCnt + entryCnt / 8), (std::size_t)8);
+    }
+    HashMap(const allocator_type &allocator, std::size_t numExpectedEntries)
+        : _entries{allocator, evaluateTableSize(numExpectedEntries)},
+          _status{allocator, packed_key_v ? (std::size_t)0 : evaluateTableSize(numExpectedEntries)},
+          _allocator{allocator},
+          _tableSize{static_cast<index_type>(evaluateTableSize(numExpectedEntries))},
+          _cnt{allocator, 1},
+          _overflowCnt{allocator, 1} {
+      _cnt.setVal((index_type)0);
+      _overflowCnt.setVal((index_type)0);
+    }
+    HashMap(std::size_t numExpectedEntries, memsrc_e mre = memsrc_e::host, ProcID devid = -1)
+        : HashMap{get_default_allocator(mre, devid), numExpectedEntries} {}
+    HashMap(memsrc_e mre = memsrc_e::host, ProcID devid = -1)
+        : HashMap{get_default_allocator(mre, devid), (std::size_t)0} {}
+
+    ~HashMap() = default;
+
+    HashMap(const HashMap &o)
+        : _entries{o._entries},
+          _status{o._status},
+          _allocator{o._allocator},
+          _tableSize{o._tableSize},
+          _cnt{o._cnt},
+          _overflowCnt{o._overflowCnt} {}
+    HashMap &operator=(const HashMap &o) {
+      if (this == &o) return *this;
+      HashMap tmp(o);
+      swap(tmp);
+      return *this;
+    }
+    HashMap clone(const allocator_type &allocator) const {
+      HashMap ret{allocator, (std::size_t)0};
+      ret._entries = _entries.clone(allocator);
+      ret._status = _status.clone(allocator);
+      ret._tableSize = _tableSize;
+      if (_cnt.size() > 0) ret._cnt.setVal(_cnt.getVal());
+      if (_overflowCnt.size() > 0) ret._overflowCnt.setVal(_overflowCnt.getVal());
+      return ret;
+    }
+    HashMap clone(const MemoryLocation &mloc) const {
+      return clone(get_default_allocator(mloc.memspace(), mloc.devid()));
+    }
+
+    HashMap(HashMap &&o) noexcept {
+      const HashMap defaultMap{};
+      _entries = std::exchange(o._entries, defaultMap._entries);
+      _status = std::exchange(o._status, defaultMap._status);
+      _allocator = std::exchange(o._allocator, defaultMap._allocator);
+      _tableSize = std::exchange(o._tableSize, defaultMap._tableSize);
+      _cnt = std::exchange(o._cnt, defaultMap._cnt);
+      _overflowCnt = std::exchange(o._overflowCnt, defaultMap._overflowCnt);
+    }
+    HashMap &operator=(HashMap &&o) noexcept {
+      if (this == &o) return *this;
+      HashMap tmp(std::move(o));
+      swap(tmp);
+      return *this;
+    }
+    void swap(HashMap &o) noexcept {
+      std::swap(_entries, o._entries);
+      std::swap(_status, o._status);
+      std::swap(_allocator, o._allocator);
+      std::swap(_tableSize, o._tableSize);
+      std::swap(_cnt, o._cnt);
+      std::swap(_overflowCnt, o._overflowCnt);
+    }
+    friend void swap(HashMap &a, HashMap &b) { a.swap(b); }
+
+    inline index_type size() const { return _cnt.getVal(0); }
+    /// number of insertions rejected because every slot was taken
+    inline index_type overflow_count() const { return _overflowCnt.getVal(0); }
+    constexpr index_type capacity() const noexcept { return _tableSize; }
+
+    template <typename Policy> void reset(Policy &&);
+    /// rehashes every entry into a table able to hold numExpectedEntries
+    template <typename Policy> void resize(Policy &&, std::size_t numExpectedEntries);
+
+    Vector<entry_t, allocator_type> _entries;
+    Vector<status_t, allocator_type> _status;
+    allocator_type _allocator;
+    index_type _tableSize;
+    Vector<index_type, allocator_type> _cnt;
+    Vector<index_type, allocator_type> _overflowCnt;
+  };
+
+  /// proxy to work within each backends
+  template <execspace_e space, typename HashMapT, typename = void> struct HashMapView {
+    static constexpr bool is_const_structure = std::is_const_v<HashMapT>;
+    using hash_map_type = std::remove_const_t<HashMapT>;
+    static constexpr auto exectag = wrapv<space>{};
+    using key_t = typename hash_map_type::key_t;
+    using mapped_t = typename hash_map_type::mapped_t;
+    using entry_t = typename hash_map_type::entry_t;
+    using storage_key_t = typename hash_map_type::storage_key_t;
+    using index_type = typename hash_map_type::index_type;
+    using size_type = typename hash_map_type::size_type;
+    using status_t = typename hash_map_type::status_t;
+    using unsigned_index_t = std::make_unsigned_t<index_type>;
+
+    static constexpr auto storage_key_sentinel_v = hash_map_type::storage_key_sentinel_v;
+    static constexpr auto sentinel_v = hash_map_type::sentinel_v;
+    static constexpr auto status_sentinel_v = hash_map_type::status_sentinel_v;
+
+    HashMapView() noexcept = default;
+    explicit constexpr HashMapView(HashMapT &map)
+        : _entries{map._entries.data()},
+          _status{hash_map_type::packed_key_v ? nullptr : map._status.data()},
+          _tableSize{map._tableSize},
+          _cnt{map._cnt.data()},
+          _overflowCnt{map._overflowCnt.data()} {}
+
+    /// returns true if the key was not present before, the value is overwritten either way
+#if defined(__CUDACC__)
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V> = 0>
+    __forceinline__ __device__ bool insert_or_assign(const key_t &key,
+                                                     const mapped_t &val) noexcept {
+      bool inserted = false;
+      const index_type slot = claim(hash_map_type::pack_key(key), inserted);
+      if (slot == sentinel_v) return false;
+      _entries[slot].value = val;
+      return inserted;
+    }
+#endif
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V> = 0>
+    inline bool insert_or_assign(const key_t &key, const mapped_t &val) {
+      bool inserted = false;
+      const index_type slot = claim(hash_map_type::pack_key(key), inserted);
+      if (slot == sentinel_v) return false;
+      _entries[slot].value = val;
+      return inserted;
+    }
+
+    /// replaces the value of key (default-constructed if absent) with op(value) through a CAS
+    /// loop, returns the previous value. values must be of 4 or 8 bytes
+#if defined(__CUDACC__)
+    template <typename Op, execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V> = 0>
+    __forceinline__ __device__ mapped_t atomic_update(const key_t &key, Op &&op) noexcept {
+      static_assert(sizeof(mapped_t) == 4 || sizeof(mapped_t) == 8,
+                    "atomic_update requires values of 4 or 8 bytes!");
+      using word_t = conditional_t<sizeof(mapped_t) == 4, unsigned int, unsigned long long int>;
+      bool inserted = false;
+      const index_type slot = claim(hash_map_type::pack_key(key), inserted);
+      if (slot == sentinel_v) return mapped_t{};
+      word_t *dst = (word_t *)&_entries[slot].value;
+      word_t old = *dst, assumed{};
+      do {
+        assumed = old;
+        old = atomic_cas(exectag, dst, assumed, bits_of<word_t>(op(value_of(assumed))));
+      } while (old != assumed);
+      return value_of(old);
+    }
+#endif
+    template <typename Op, execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V> = 0>
+    inline mapped_t atomic_update(const key_t &key, Op &&op) {
+      static_assert(sizeof(mapped_t) == 4 || sizeof(mapped_t) == 8,
+                    "atomic_update requires values of 4 or 8 bytes!");
+      using word_t = conditional_t<sizeof(mapped_t) == 4, u32, u64>;
+      bool inserted = false;
+      const index_type slot = claim(hash_map_type::pack_key(key), inserted);
+      if (slot == sentinel_v) return mapped_t{};
+      word_t *dst = (word_t *)&_entries[slot].value;
+      word_t old = *dst, assumed{};
+      do {
+        assumed = old;
+        old = atomic_cas(exectag, dst, assumed, bits_of<word_t>(op(value_of(assumed))));
+      } while (old != assumed);
+      return value_of(old);
+    }
+
+    /// make sure no one else is inserting the same key in the same time!
+    constexpr auto find(const key_t &key) const noexcept {
+      using ptr_t = conditional_t<is_const_structure, const mapped_t *, mapped_t *>;
+      const storage_key_t storageKey = hash_map_type::pack_key(key);
+      index_type slot = initial_slot(storageKey);
+      for (index_type probes = 0; probes != _tableSize; ++probes) {
+        if (_entries[slot].key == storageKey) return (ptr_t)&_entries[slot].value;
+        if (_entries[slot].key == storage_key_sentinel_v) return (ptr_t) nullptr;
+        slot = (slot + 1) & (_tableSize - 1);
+      }
+      return (ptr_t) nullptr;
+    }
+    constexpr bool contains(const key_t &key) const noexcept { return find(key) != nullptr; }
+
+    constexpr auto size() const noexcept { return *_cnt; }
+
+    conditional_t<is_const_structure, const entry_t *, entry_t *> _entries{nullptr};
+    conditional_t<is_const_structure, const status_t *, status_t *> _status{nullptr};
+    index_type _tableSize{0};
+    conditional_t<is_const_structure, const index_type *, index_type *> _cnt{nullptr};
+    conditional_t<is_const_structure, const index_type *, index_type *> _overflowCnt{nullptr};
+
+  protected:
+    template <typename WordT> static constexpr WordT bits_of(const mapped_t &val) noexcept {
+      WordT ret{};
+      std::memcpy(&ret, &val, sizeof(WordT));
+      return ret;
+    }
+    template <typename WordT> static constexpr mapped_t value_of(const WordT &word) noexcept {
+      mapped_t ret{};
+      std::memcpy(&ret, &word, sizeof(WordT));
+      return ret;
+    }
+    constexpr index_type initial_slot(const storage_key_t &storageKey) const noexcept {
+      u64 ret{};
+      if constexpr (hash_map_type::packed_key_v)
+        ret = (u64)storageKey;
+      else {
+        std::size_t seed = storageKey[0];
+        for (int d = 1; d < key_t::extent; ++d) hash_combine(seed, storageKey[d]);
+        ret = (u64)seed;
+      }
+      return (index_type)(hash(ret) & (u64)(_tableSize - 1));
+    }
+
+#if defined(__CUDACC__)
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V> = 0>
+    __forceinline__ __device__ index_type claim(const storage_key_t &storageKey,
+                                                bool &inserted) noexcept {
+      index_type slot = initial_slot(storageKey);
+      for (index_type probes = 0; probes != _tableSize; ++probes) {
+        const storage_key_t storedKey = atomicKeyCAS(slot, storageKey);
+        if (storedKey == storage_key_sentinel_v) {
+          atomic_add(exectag, (unsigned_index_t *)_cnt, (unsigned_index_t)1);
+          inserted = true;
+          return slot;
+        }
+        if (storedKey == storageKey) return slot;
+        slot = (slot + 1) & (_tableSize - 1);
+      }
+      atomic_add(exectag, (unsigned_index_t *)_overflowCnt, (unsigned_index_t)1);
+      return sentinel_v;
+    }
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V> = 0>
+    __forceinline__ __device__ storage_key_t atomicKeyCAS(index_type slot,
+                                                          const storage_key_t &val) noexcept {
+      constexpr auto execTag = wrapv<S>{};
+      if constexpr (hash_map_type::packed_key_v) {
+        if (auto storedKey = _entries[slot].key; storedKey != storage_key_sentinel_v)
+          return storedKey;
+        return atomic_cas(execTag, &_entries[slot].key, storage_key_sentinel_v, val);
+      } else {
+        status_t *lock = &_status[slot];
+        volatile storage_key_t *const dest = &_entries[slot].key;
+        storage_key_t return_val{};
+        int done = 0;
+        unsigned int mask = active_mask(execTag);
+        unsigned int active = ballot_sync(execTag, mask, 1);
+        unsigned int done_active = 0;
+        while (active != done_active) {
+          if (!done) {
+            if (atomic_cas(execTag, lock, status_sentinel_v, (status_t)0) == status_sentinel_v) {
+              thread_fence(execTag);
+              (void)(return_val = *const_cast<storage_key_t *>(dest));
+              if (return_val == storage_key_sentinel_v)
+                for (int d = 0; d < key_t::extent; ++d) (void)(dest->data()[d] = val[d]);
+              thread_fence(execTag);
+              atomic_exch(execTag, lock, status_sentinel_v);
+              done = 1;
+            }
+          }
+          done_active = ballot_sync(execTag, mask, done);
+        }
+        return return_val;
+      }
+    }
+#endif
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V> = 0>
+    inline index_type claim(const storage_key_t &storageKey, bool &inserted) {
+      index_type slot = initial_slot(storageKey);
+      for (index_type probes = 0; probes != _tableSize; ++probes) {
+        const storage_key_t storedKey = atomicKeyCAS(slot, storageKey);
+        if (storedKey == storage_key_sentinel_v) {
+          atomic_add(exectag, (unsigned_index_t *)_cnt, (unsigned_index_t)1);
+          inserted = true;
+          return slot;
+        }
+        if (storedKey == storageKey) return slot;
+        slot = (slot + 1) & (_tableSize - 1);
+      }
+      atomic_add(exectag, (unsigned_index_t *)_overflowCnt, (unsigned_index_t)1);
+      return sentinel_v;
+    }
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V> = 0>
+    inline storage_key_t atomicKeyCAS(index_type slot, const storage_key_t &val) {
+      constexpr auto execTag = wrapv<S>{};
+      if constexpr (hash_map_type::packed_key_v) {
+        if (auto storedKey = _entries[slot].key; storedKey != storage_key_sentinel_v)
+          return storedKey;
+        return atomic_cas(execTag, &_entries[slot].key, storage_key_sentinel_v, val);
+      } else {
+        status_t *lock = &_status[slot];
+        volatile storage_key_t *const dest = &_entries[slot].key;
+        storage_key_t return_val{};
+        bool done = false;
+        while (!done) {
+          if (atomic_cas(execTag, lock, status_sentinel_v, (status_t)0) == status_sentinel_v) {
+            (void)(return_val = *const_cast<storage_key_t *>(dest));
+            if (return_val == storage_key_sentinel_v)
+              for (int d = 0; d < key_t::extent; ++d) (void)(dest->data()[d] = val[d]);
+            atomic_exch(execTag, lock, status_sentinel_v);
+            done = true;
+          }
+        }
+        return return_val;
+      }
+    }
+  };
+
+  template <execspace_e ExecSpace, typename Key, typename Value, typename Allocator>
+  constexpr decltype(auto) proxy(HashMap<Key, Value, Allocator> &map) {
+    return HashMapView<ExecSpace, HashMap<Key, Value, Allocator>>{map};
+  }
+  template <execspace_e ExecSpace, typename Key, typename Value, typename Allocator>
+  constexpr decltype(auto) proxy(const HashMap<Key, Value, Allocator> &map) {
+    return HashMapView<ExecSpace, const HashMap<Key, Value, Allocator>>{map};
+  }
+
+  template <typename HashMapView> struct ResetHashMap {
+    using hash_map_type = typename HashMapView::hash_map_type;
+    explicit ResetHashMap(HashMapView mv) : map{mv} {}
+    constexpr void operator()(typename HashMapView::size_type slot) noexcept {
+      map._entries[slot].key = hash_map_type::storage_key_sentinel_v;
+      map._entries[slot].value = typename HashMapView::mapped_t{};
+      if constexpr (!hash_map_type::packed_key_v)
+        map._status[slot] = hash_map_type::status_sentinel_v;
+      if (slot == 0) {
+        *map._cnt = 0;
+        *map._overflowCnt = 0;
+      }
+    }
+    HashMapView map;
+  };
+  template <typename EntriesView, typename HashMapView> struct ReinsertHashMapEntries {
+    using hash_map_type = typename HashMapView::hash_map_type;
+    explicit ReinsertHashMapEntries(EntriesView entries, HashMapView mv)
+        : entries{entries}, map{mv} {}
+    constexpr void operator()(typename EntriesView::size_type slot) noexcept {
+      const auto &e = entries[slot];
+      if (e.key == hash_map_type::storage_key_sentinel_v) return;
+      map.insert_or_assign(hash_map_type::unpack_key(e.key), e.value);
+    }
+    EntriesView entries;
+    HashMapView map;
+  };
+
+  template <typename Key, typename Value, typename Allocator> template <typename Policy>
+  void HashMap<Key, Value, Allocator>::reset(Policy &&policy) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    policy(range(_tableSize), ResetHashMap{proxy<space>(*this)});
+  }
+
+  template <typename Key, typename Value, typename Allocator> template <typename Policy>
+  void HashMap<Key, Value, Allocator>::resize(Policy &&policy, std::size_t numExpectedEntries) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    const auto newTableSize = evaluateTableSize(numExpectedEntries);
+    if (newTableSize <= (std::size_t)_tableSize) return;
+    auto entries = std::exchange(_entries, Vector<entry_t, allocator_type>{_allocator, newTableSize});
+    if constexpr (!packed_key_v) _status.resize(newTableSize);
+    _tableSize = newTableSize;
+    policy(range(newTableSize), ResetHashMap{proxy<space>(*this)});
+    policy(range(entries.size()),
+           ReinsertHashMapEntries{proxy<space>(std::as_const(entries)), proxy<space>(*this)});
+  }
+
+}  // namespace zs
@@ -12,7 +12,12 @@
 
 namespace zs {
 
-  template <typename Tn_, int dim_, typename Index = int, typename AllocatorT = ZSPmrAllocator<>>
+  /// strided: slots probed with a stride of 127, tables reserved 16x the expected entries
+  /// bucketed: slots grouped into 8-wide buckets probed linearly, works at 80-90% load
+  enum struct hash_layout_e { strided = 0, bucketed };
+
+  template <typename Tn_, int dim_, typename Index = int, typename AllocatorT = ZSPmrAllocator<>,
+            hash_layout_e Layout = hash_layout_e::strided>
   struct HashTable {
     static_assert(is_zs_allocator<AllocatorT>::value,
                   "Hashtable only works with zspmrallocator for now.");
@@ -26,6 +31,14 @@ namespace zs {
     using value_t = std::make_signed_t<Index>;
     using status_t = int;
 
+    /// keys whose full range fits in a single machine word are stored packed, thus claimed by
+    /// one CAS without any per-slot lock (no status array). wider keys, e.g. i32 dim-3, keep the
+    /// locked path rather than truncating coordinates that would then alias
+    static constexpr bool packed_key_v = std::is_integral_v<Tn> && sizeof(Tn) * dim <= 8;
+    using storage_key_t
+        = conditional_t<packed_key_v, conditional_t<(sizeof(Tn) * dim <= 4), u32, u64>, key_t>;
+    static constexpr int key_bits_per_axis_v = packed_key_v ? (int)sizeof(Tn) * 8 : 0;
+
     using index_type = Tn;
 
     using value_type = key_t;
@@ -46,14 +59,14 @@ namespace zs {
       Table(const allocator_type &allocator, std::size_t numEntries)
           : keys{allocator, numEntries},
             indices{allocator, numEntries},
-            status{allocator, numEntries} {}
+            status{allocator, packed_key_v ? (std::size_t)0 : numEntries} {}
       void resize(size_type size) {
         keys.resize(size);
         indices.resize(size);
-        status.resize(size);
+        if constexpr (!packed_key_v) status.resize(size);
       }
 
-      Vector<key_t, allocator_type> keys;
+      Vector<storage_key_t, allocator_type> keys;
       Vector<value_t, allocator_type> indices;
       Vector<status_t, allocator_type> status;
     };
@@ -66,8 +79,45 @@ namespace zs {
 
     static constexpr Tn key_scalar_sentinel_v = limits<Tn>::max();
     static constexpr value_t sentinel_v{-1};  // this requires value_t to be signed type
+    /// index of an erased key, whose slot keeps the key so that probing goes on past it
+    static constexpr value_t tombstone_v{-2};
     static constexpr status_t status_sentinel_v{-1};
     static constexpr std::size_t reserve_ratio_v = 16;
+    static constexpr bool bucketed_v = Layout == hash_layout_e::bucketed;
+    /// a bucket of packed 64-bit keys spans one cache line
+    static constexpr int bucket_size_v = 8;
+    /// bucketed insertions giving up after this many probed slots count as overflowed, so that a
+    /// table outgrowing its working set gets grown instead of walking ever longer probe chains.
+    /// strided slots follow the unmixed key hash, under which lattices of nearby coordinates
+    /// legitimately form long chains, so strided insertions keep probing the whole table
+    static constexpr int max_probe_length_v
+        = bucketed_v ? 64 * bucket_size_v : limits<int>::max();
+
+    template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
+                                           std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
+    static constexpr storage_key_t pack_key(const VecInterface<VecT> &key) noexcept {
+      if constexpr (packed_key_v && dim == 1)
+        return (storage_key_t)(std::make_unsigned_t<Tn>)(Tn)key[0];
+      else if constexpr (packed_key_v) {
+        constexpr storage_key_t mask = ((storage_key_t)1 << key_bits_per_axis_v) - 1;
+        storage_key_t ret{0};
+        for (int d = 0; d != dim; ++d)
+          ret = (ret << key_bits_per_axis_v) | ((storage_key_t)(Tn)key[d] & mask);
+        return ret;
+      } else {
+        key_t ret{};
+        for (int d = 0; d != dim; ++d) ret[d] = key[d];
+        return ret;
+      }
+    }
+    static constexpr storage_key_t deduce_storage_key_sentinel() noexcept {
+      /// a partially packed word never has its top bit set, which is then free for the sentinel
+      if constexpr (packed_key_v && key_bits_per_axis_v * dim < (int)sizeof(storage_key_t) * 8)
+        return ~(storage_key_t)0;
+      else
+        return pack_key(key_t::uniform(key_scalar_sentinel_v));
+    }
+    static constexpr storage_key_t storage_key_sentinel_v = deduce_storage_key_sentinel();
 
     constexpr decltype(auto) memoryLocation() const noexcept { return _allocator.location; }
     constexpr ProcID devid() const noexcept { return memoryLocation().devid(); }
@@ -85,15 +135,20 @@ namespace zs {
 
     constexpr std::size_t evaluateTableSize(std::size_t entryCnt) const {
       if (entryCnt == 0) return (std::size_t)0;
-      return next_2pow(entryCnt) * reserve_ratio_v;
+      if constexpr (bucketed_v)
+        return std::max(next_2pow(entryCnt + entryCnt / 8), (std::size_t)bucket_size_v);
+      else
+        return next_2pow(entryCnt) * reserve_ratio_v;
     }
     HashTable(const allocator_type &allocator, std::size_t numExpectedEntries)
         : _table{allocator, evaluateTableSize(numExpectedEntries)},
           _allocator{allocator},
           _tableSize{static_cast<value_t>(evaluateTableSize(numExpectedEntries))},
           _cnt{allocator, 1},
+          _overflowCnt{allocator, 1},
           _activeKeys{allocator, evaluateTableSize(numExpectedEntries)} {
       _cnt.setVal((value_t)0);
+      _overflowCnt.setVal((value_t)0);
     }
     HashTable(std::size_t numExpectedEntries, memsrc_e mre = memsrc_e::host, ProcID devid = -1)
         : HashTable{get_default_allocator(mre, devid), numExpectedEntries} {}
@@ -107,6 +162,7 @@ namespace zs {
           _allocator{o._allocator},
           _tableSize{o._tableSize},
           _cnt{o._cnt},
+          _overflowCnt{o._overflowCnt},
           _activeKeys{o._activeKeys} {}
     HashTable &operator=(const HashTable &o) {
       if (this == &o) return *this;
@@ -115,14 +171,15 @@ namespace zs {
       return *this;
     }
     HashTable clone(const allocator_type &allocator) const {
-      HashTable ret{allocator, _tableSize / reserve_ratio_v};
+      HashTable ret{allocator, (std::size_t)0};
       if (_cnt.size() > 0) ret._cnt.setVal(_cnt.getVal());
+      if (_overflowCnt.size() > 0) ret._overflowCnt.setVal(_overflowCnt.getVal());
       ret._tableSize = _tableSize;
       ret._activeKeys = _activeKeys.clone(allocator);
       if (_tableSize > 0) {
         ret.self().keys = self().keys.clone(allocator);
         ret.self().indices = self().indices.clone(allocator);
-        ret.self().status = self().status.clone(allocator);
+        if constexpr (!packed_key_v) ret.self().status = self().status.clone(allocator);
       }
       return ret;
     }
@@ -137,6 +194,7 @@ namespace zs {
       _tableSize = std::exchange(o._tableSize, defaultTable._tableSize);
       /// critical! use user-defined move assignment constructor!
       _cnt = std::exchange(o._cnt, defaultTable._cnt);
+      _overflowCnt = std::exchange(o._overflowCnt, defaultTable._overflowCnt);
       _activeKeys = std::exchange(o._activeKeys, defaultTable._activeKeys);
     }
     HashTable &operator=(HashTable &&o) noexcept {
@@ -150,11 +208,14 @@ namespace zs {
       std::swap(_allocator, o._allocator);
       std::swap(_tableSize, o._tableSize);
       std::swap(_cnt, o._cnt);
+      std::swap(_overflowCnt, o._overflowCnt);
       std::swap(_activeKeys, o._activeKeys);
     }
     friend void swap(HashTable &a, HashTable &b) { a.swap(b); }
 
     inline value_t size() const { return _cnt.getVal(0); }
+    /// number of insertions rejected since the last grow because the table ran out of room
+    inline value_t overflow_count() const { return _overflowCnt.getVal(0); }
 
     struct iterator_impl : IteratorInterface<iterator_impl> {
       template <typename Ti> constexpr iterator_impl(key_t *base, Ti &&idx)
@@ -203,11 +264,24 @@ namespace zs {
     template <typename Policy> void resize(Policy &&, std::size_t numExpectedEntries);
     template <typename Policy> void preserve(Policy &&, std::size_t numExpectedEntries);
     template <typename Policy> void reset(Policy &&, bool clearCnt);
+    /// inserts a batch of (possibly duplicated) keys, returns the index of each key
+    /// packed keys are radix-sorted and deduplicated first so that each distinct key is
+    /// inserted exactly once
+    template <typename Policy> Vector<value_t, allocator_type> insert_bulk(
+        Policy &&, const Vector<key_t, allocator_type> &keys);
+    /// same as insert_bulk, but rehashes into a larger table and retries whenever some
+    /// insertions overflow
+    template <typename Policy> Vector<value_t, allocator_type> insert_or_grow(
+        Policy &&, const Vector<key_t, allocator_type> &keys);
+    /// drops erased keys from _activeKeys and rehashes the rest densely, returns the new index
+    /// of every previous index (sentinel_v for erased ones)
+    template <typename Policy> Vector<value_t, allocator_type> compact(Policy &&);
 
     Table _table;
     allocator_type _allocator;
     value_t _tableSize;
     Vector<value_t, allocator_type> _cnt;
+    Vector<value_t, allocator_type> _overflowCnt;
     Vector<key_t, allocator_type> _activeKeys;
   };
 
@@ -231,12 +305,14 @@ namespace zs {
 
     constexpr void operator()(typename HashTableView::size_type entry) noexcept {
       using namespace placeholders;
-      table._table.keys[entry]
-          = hash_table_type::key_t::uniform(hash_table_type::key_scalar_sentinel_v);
+      table._table.keys[entry] = hash_table_type::storage_key_sentinel_v;
       table._table.indices[entry]
           = hash_table_type::sentinel_v;  // necessary for query to terminate
-      table._table.status[entry] = -1;
-      if (entry == 0 && clearCnt) *table._cnt = 0;
+      if constexpr (!hash_table_type::packed_key_v) table._table.status[entry] = -1;
+      if (entry == 0 && clearCnt) {
+        *table._cnt = 0;
+        *table._overflowCnt = 0;
+      }
     }
 
     HashTableView table;
@@ -251,6 +327,16 @@ namespace zs {
 
     HashTableView table;
   };
+  template <typename HashTableView, typename MarksView> struct ReinsertLiveHashTableKeys {
+    explicit ReinsertLiveHashTableKeys(HashTableView tv, MarksView live) : table{tv}, live{live} {}
+
+    constexpr void operator()(typename HashTableView::size_type entry) noexcept {
+      if (live[entry]) table.insert(table._activeKeys[entry], entry);
+    }
+
+    HashTableView table;
+    MarksView live;
+  };
   template <typename HashTableView> struct RemoveHashTableEntries {
     using hash_table_type = typename HashTableView::hash_table_type;
     explicit RemoveHashTableEntries(HashTableView tv) : table{tv} {}
@@ -259,11 +345,10 @@ namespace zs {
       auto entry = table.entry(blockid);
       if (entry == hash_table_type::sentinel_v)
         printf("%llu-th key does not exist in the table??\n", (unsigned long long)blockno);
-      table._table.keys[entry]
-          = hash_table_type::key_t::uniform(hash_table_type::key_scalar_sentinel_v);
+      table._table.keys[entry] = hash_table_type::storage_key_sentinel_v;
       table._table.indices[entry]
           = hash_table_type::sentinel_v;  // necessary for query to terminate
-      table._table.status[entry] = -1;
+      if constexpr (!hash_table_type::packed_key_v) table._table.status[entry] = -1;
     }
     HashTableView table;
   };
@@ -278,13 +363,199 @@ namespace zs {
     typename HashTableView::value_t cnt;
   };
 
-  template <typename Tn, int dim, typename Index, typename Allocator> template <typename Policy>
-  void HashTable<Tn, dim, Index, Allocator>::preserve(Policy &&policy,
+  template <typename HashTableView> struct HashTableKeyErased {
+    explicit HashTableKeyErased(HashTableView tv) : table{tv} {}
+    constexpr bool operator()(typename HashTableView::size_type i) noexcept {
+      /// erased keys are tombstoned, revived ones have been assigned another index
+      return table.query(table._activeKeys[i]) != (typename HashTableView::value_t)i;
+    }
+    HashTableView table;
+  };
+  template <typename HashTableView, typename KeysView, typename MarksView, typename IndicesView>
+  struct CompactHashTableKeys {
+    explicit CompactHashTableKeys(HashTableView tv, KeysView keys, MarksView marks,
+                                  MarksView offsets, IndicesView remap)
+        : table{tv}, keys{keys}, marks{marks}, offsets{offsets}, remap{remap} {}
+    constexpr void operator()(typename HashTableView::size_type i) noexcept {
+      if (marks[i]) {
+        keys[offsets[i]] = table._activeKeys[i];
+        remap[i] = offsets[i];
+      } else
+        remap[i] = HashTableView::sentinel_v;
+    }
+    HashTableView table;
+    KeysView keys;
+    MarksView marks, offsets;
+    IndicesView remap;
+  };
+
+  template <typename HashTableView, typename KeysView, typename CodesView, typename IndicesView>
+  struct PackHashTableKeys {
+    using hash_table_type = typename HashTableView::hash_table_type;
+    explicit PackHashTableKeys(HashTableView, KeysView keys, CodesView codes, IndicesView ids)
+        : keys{keys}, codes{codes}, ids{ids} {}
+    constexpr void operator()(typename HashTableView::size_type i) noexcept {
+      codes[i] = hash_table_type::pack_key(keys[i]);
+      ids[i] = i;
+    }
+    KeysView keys;
+    CodesView codes;
+    IndicesView ids;
+  };
+  template <typename CodesView, typename MarksView> struct MarkHashTableKeyRuns {
+    explicit MarkHashTableKeyRuns(CodesView codes, MarksView marks) : codes{codes}, marks{marks} {}
+    constexpr void operator()(typename CodesView::size_type i) noexcept {
+      marks[i] = (i == 0 || codes[i] != codes[i - 1]) ? 1 : 0;
+    }
+    CodesView codes;
+    MarksView marks;
+  };
+  template <typename HashTableView, typename KeysView, typename IndicesView>
+  struct InsertUniqueHashTableKeys {
+    explicit InsertUniqueHashTableKeys(HashTableView tv, KeysView keys, IndicesView sortedIds,
+                                       IndicesView marks, IndicesView runNos,
+                                       IndicesView runIndices)
+        : table{tv},
+          keys{keys},
+          sortedIds{sortedIds},
+          marks{marks},
+          runNos{runNos},
+          runIndices{runIndices} {}
+    constexpr void operator()(typename HashTableView::size_type i) noexcept {
+      if (marks[i] == 0) return;
+      const auto &key = keys[sortedIds[i]];
+      auto no = table.insert(key);
+      /// the key was already present before this batch
+      if (no == HashTableView::sentinel_v) no = table.query(key);
+      runIndices[runNos[i] - 1] = no;
+    }
+    HashTableView table;
+    KeysView keys;
+    IndicesView sortedIds, marks, runNos, runIndices;
+  };
+  template <typename IndicesView> struct ScatterHashTableKeyIndices {
+    explicit ScatterHashTableKeyIndices(IndicesView sortedIds, IndicesView runNos,
+                                        IndicesView runIndices, IndicesView dst)
+        : sortedIds{sortedIds}, runNos{runNos}, runIndices{runIndices}, dst{dst} {}
+    constexpr void operator()(typename IndicesView::size_type i) noexcept {
+      dst[sortedIds[i]] = runIndices[runNos[i] - 1];
+    }
+    IndicesView sortedIds, runNos, runIndices, dst;
+  };
+  template <typename HashTableView, typename KeysView> struct InsertHashTableKeys {
+    explicit InsertHashTableKeys(HashTableView tv, KeysView keys) : table{tv}, keys{keys} {}
+    constexpr void operator()(typename HashTableView::size_type i) noexcept {
+      table.insert(keys[i]);
+    }
+    HashTableView table;
+    KeysView keys;
+  };
+  template <typename HashTableView, typename KeysView, typename IndicesView>
+  struct QueryHashTableKeys {
+    explicit QueryHashTableKeys(HashTableView tv, KeysView keys, IndicesView dst)
+        : table{tv}, keys{keys}, dst{dst} {}
+    constexpr void operator()(typename HashTableView::size_type i) noexcept {
+      dst[i] = table.query(keys[i]);
+    }
+    HashTableView table;
+    KeysView keys;
+    IndicesView dst;
+  };
+
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  auto HashTable<Tn, dim, Index, Allocator, Layout>::insert_bulk(
+      Policy &&policy, const Vector<key_t, allocator_type> &keys)
+      -> Vector<value_t, allocator_type> {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    const auto numKeys = keys.size();
+    Vector<value_t, allocator_type> ret{_allocator, numKeys};
+    if (numKeys == 0) return ret;
+    if constexpr (packed_key_v) {
+      /// sort
+      Vector<storage_key_t, allocator_type> codes{_allocator, numKeys},
+          sortedCodes{_allocator, numKeys};
+      Vector<value_t, allocator_type> ids{_allocator, numKeys}, sortedIds{_allocator, numKeys};
+      policy(range(numKeys), PackHashTableKeys{proxy<space>(*this), proxy<space>(keys),
+                                               proxy<space>(codes), proxy<space>(ids)});
+      radix_sort_pair(policy, codes.begin(), ids.begin(), sortedCodes.begin(), sortedIds.begin(),
+                      numKeys);
+      /// deduplicate
+      Vector<value_t, allocator_type> marks{_allocator, numKeys}, runNos{_allocator, numKeys};
+      policy(range(numKeys),
+             MarkHashTableKeyRuns{proxy<space>(sortedCodes), proxy<space>(marks)});
+      inclusive_scan(policy, marks.begin(), marks.end(), runNos.begin());
+      /// insert distinct keys, then broadcast their indices
+      Vector<value_t, allocator_type> runIndices{_allocator, numKeys};
+      policy(range(numKeys),
+             InsertUniqueHashTableKeys{proxy<space>(*this), proxy<space>(keys),
+                                       proxy<space>(sortedIds), proxy<space>(marks),
+                                       proxy<space>(runNos), proxy<space>(runIndices)});
+      policy(range(numKeys),
+             ScatterHashTableKeyIndices{proxy<space>(sortedIds), proxy<space>(runNos),
+                                        proxy<space>(runIndices), proxy<space>(ret)});
+    } else {
+      policy(range(numKeys), InsertHashTableKeys{proxy<space>(*this), proxy<space>(keys)});
+      policy(range(numKeys),
+             QueryHashTableKeys{proxy<space>(*this), proxy<space>(keys), proxy<space>(ret)});
+    }
+    return ret;
+  }
+
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  auto HashTable<Tn, dim, Index, Allocator, Layout>::insert_or_grow(
+      Policy &&policy, const Vector<key_t, allocator_type> &keys)
+      -> Vector<value_t, allocator_type> {
+    if (_tableSize == 0) resize(policy, keys.size());
+    while (true) {
+      auto ret = insert_bulk(policy, keys);
+      if (overflow_count() == 0) return ret;
+      /// rehash the accepted insertions into a table twice as large, keys that made it in
+      /// before the overflow are skipped on retry
+      _overflowCnt.setVal((value_t)0);
+      if constexpr (bucketed_v)
+        resize(policy, (std::size_t)_tableSize);
+      else
+        resize(policy, (std::size_t)_tableSize / reserve_ratio_v * 2);
+    }
+  }
+
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  auto HashTable<Tn, dim, Index, Allocator, Layout>::compact(Policy &&policy)
+      -> Vector<value_t, allocator_type> {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    const std::size_t numEntries = std::min(size(), _tableSize);
+    Vector<value_t, allocator_type> remap{_allocator, numEntries};
+    if (numEntries == 0) return remap;
+    const auto kept = mark_erasure(policy, memoryLocation(), numEntries,
+                                   HashTableKeyErased{proxy<space>(*this)});
+    const auto numLiveEntries = (value_t)kept.numKept;
+    Vector<key_t, allocator_type> keys{_allocator, _activeKeys.size()};
+    policy(range(numEntries),
+           CompactHashTableKeys{proxy<space>(*this), proxy<space>(keys), proxy<space>(kept.marks),
+                                proxy<space>(kept.offsets), proxy<space>(remap)});
+    /// rehash, which also clears the tombstones
+    _activeKeys = std::move(keys);
+    _cnt.setVal(numLiveEntries);
+    policy(range(_tableSize), ResetHashTable{proxy<space>(*this), false});  // don't clear cnt
+    policy(range(numLiveEntries), ReinsertHashTable{proxy<space>(*this)});
+    return remap;
+  }
+
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  void HashTable<Tn, dim, Index, Allocator, Layout>::preserve(Policy &&policy,
                                                       std::size_t numExpectedEntries) {
     constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
     const auto numEntries = size();
     if (numExpectedEntries == numEntries) return;
     using LsvT = decltype(proxy<space>(*this));
+    /// erased keys stay in _activeKeys, only the entries the table still maps to are rehashed
+    Vector<value_t, allocator_type> live{_allocator, (std::size_t)numEntries};
+    policy(range(numEntries),
+           MarkUnerased{proxy<space>(live), HashTableKeyErased<LsvT>{proxy<space>(*this)}});
     policy(range(1), ResetHashTableCounter<LsvT>{proxy<space>(*this),
                                                  (typename LsvT::value_t)numExpectedEntries});
     const auto newTableSize = evaluateTableSize(numExpectedEntries);
@@ -298,25 +569,31 @@ namespace zs {
     } else
       policy(range(numEntries), RemoveHashTableEntries<LsvT>{proxy<space>(*this)});
     policy(range(std::min((std::size_t)numEntries, numExpectedEntries)),
-           ReinsertHashTable<LsvT>{proxy<space>(*this)});
+           ReinsertLiveHashTableKeys{proxy<space>(*this), proxy<space>(live)});
   }
 
-  template <typename Tn, int dim, typename Index, typename Allocator> template <typename Policy>
-  void HashTable<Tn, dim, Index, Allocator>::resize(Policy &&policy,
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  void HashTable<Tn, dim, Index, Allocator, Layout>::resize(Policy &&policy,
                                                     std::size_t numExpectedEntries) {
     constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
     const auto newTableSize = evaluateTableSize(numExpectedEntries);
     if (newTableSize <= _tableSize) return;
+    /// as in preserve, erased keys left in _activeKeys are not rehashed
+    const auto numEntries = size();
+    Vector<value_t, allocator_type> live{_allocator, (std::size_t)numEntries};
+    policy(range(numEntries),
+           MarkUnerased{proxy<space>(live), HashTableKeyErased{proxy<space>(*this)}});
     _table.resize(newTableSize);
     _tableSize = newTableSize;
     _activeKeys.resize(newTableSize);
     policy(range(newTableSize), ResetHashTable{proxy<space>(*this), false});  // don't clear cnt
-    const auto numEntries = size();
-    policy(range(numEntries), ReinsertHashTable{proxy<space>(*this)});
+    policy(range(numEntries), ReinsertLiveHashTableKeys{proxy<space>(*this), proxy<space>(live)});
   }
 
-  template <typename Tn, int dim, typename Index, typename Allocator> template <typename Policy>
-  void HashTable<Tn, dim, Index, Allocator>::reset(Policy &&policy, bool clearCnt) {
+  template <typename Tn, int dim, typename Index, typename Allocator, hash_layout_e Layout>
+  template <typename Policy>
+  void HashTable<Tn, dim, Index, Allocator, Layout>::reset(Policy &&policy, bool clearCnt) {
     constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
     using LsvT = decltype(proxy<space>(*this));
     policy(range(_tableSize), ResetHashTable<LsvT>{proxy<space>(*this), clearCnt});
@@ -349,22 +626,27 @@ namespace zs {
     static_assert(sizeof(value_t) == sizeof(unsigned_value_t),
                   "value_t and unsigned_value_t of different sizes");
     using status_t = typename hash_table_type::status_t;
+    using storage_key_t = typename hash_table_type::storage_key_t;
     struct table_t {
-      conditional_t<is_const_structure, const key_t *, key_t *> keys{nullptr};
+      conditional_t<is_const_structure, const storage_key_t *, storage_key_t *> keys{nullptr};
       conditional_t<is_const_structure, const value_t *, value_t *> indices{nullptr};
       conditional_t<is_const_structure, const status_t *, status_t *> status{nullptr};
     };
 
     static constexpr auto key_scalar_sentinel_v = hash_table_type::key_scalar_sentinel_v;
+    static constexpr auto storage_key_sentinel_v = hash_table_type::storage_key_sentinel_v;
     static constexpr auto sentinel_v = hash_table_type::sentinel_v;
+    static constexpr auto tombstone_v = hash_table_type::tombstone_v;
     static constexpr auto status_sentinel_v = hash_table_type::status_sentinel_v;
 
     HashTableView() noexcept = default;
     explicit constexpr HashTableView(HashTableT &table)
-        : _table{table.self().keys.data(), table.self().indices.data(), table.self().status.data()},
+        : _table{table.self().keys.data(), table.self().indices.data(),
+                 hash_table_type::packed_key_v ? nullptr : table.self().status.data()},
           _activeKeys{table._activeKeys.data()},
           _tableSize{table._tableSize},
-          _cnt{table._cnt.data()} {}
+          _cnt{table._cnt.data()},
+          _overflowCnt{table._overflowCnt.data()} {}
 
 #if defined(__CUDACC__)
     template <typename VecT, execspace_e S = space, bool V = is_const_structure,
@@ -372,19 +654,37 @@ namespace zs {
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     __forceinline__ __device__ value_t insert(const VecInterface<VecT> &key) noexcept {
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      key_t storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
-      for (; !(storedKey == key_sentinel_v || storedKey == key);) {
-        hashedentry = (hashedentry + 127) % _tableSize;
-        storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
+      const storage_key_t storageKey = hash_table_type::pack_key(key);
+      value_t hashedentry = initial_slot(key);
+      storage_key_t storedKey = atomicKeyCAS(hashedentry, storageKey);
+      for (value_t probes = 1;
+           !(storedKey == storage_key_sentinel_v || storedKey == storageKey); ++probes) {
+        if (probes == _tableSize || probes == hash_table_type::max_probe_length_v) {
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return HashTableT::sentinel_v;
+        }
+        hashedentry = next_slot(hashedentry);
+        storedKey = atomicKeyCAS(hashedentry, storageKey);
       }
-      if (storedKey == key_sentinel_v) {
-        auto localno = (value_t)atomic_add(exectag, (unsigned_value_t *)_cnt, (unsigned_value_t)1);
+      /// an erased key is brought back by whoever turns its tombstone into a fresh slot first
+      if (storedKey == storage_key_sentinel_v
+          || (_table.indices[hashedentry] == tombstone_v
+              && atomic_cas(exectag, &_table.indices[hashedentry], tombstone_v,
+                            HashTableT::sentinel_v)
+                     == tombstone_v)) {
+        /// the count never exceeds the room in _activeKeys
+        value_t localno = *_cnt;
+        for (value_t cnt; localno < _tableSize; localno = cnt)
+          if ((cnt = atomic_cas(exectag, _cnt, localno, localno + 1)) == localno) break;
+        if (localno >= _tableSize) {
+          /// release the slot as a tombstone, which keeps the probe chains through it intact
+          /// and lets later insertions of this key overflow (and be counted) again
+          _table.indices[hashedentry] = tombstone_v;
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return HashTableT::sentinel_v;
+        }
         _table.indices[hashedentry] = localno;
         _activeKeys[localno] = key;
-        if (localno >= _tableSize - 20)
-          printf("proximity!!! %d -> %d\n", (int)localno, (int)_tableSize);
         return localno;  ///< only the one that inserts returns the actual index
       }
       return HashTableT::sentinel_v;
@@ -395,19 +695,37 @@ namespace zs {
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     inline value_t insert(const VecInterface<VecT> &key) {
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      key_t storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
-      for (; !(storedKey == key_sentinel_v || storedKey == key);) {
-        hashedentry = (hashedentry + 127) % _tableSize;
-        storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
+      const storage_key_t storageKey = hash_table_type::pack_key(key);
+      value_t hashedentry = initial_slot(key);
+      storage_key_t storedKey = atomicKeyCAS(hashedentry, storageKey);
+      for (value_t probes = 1;
+           !(storedKey == storage_key_sentinel_v || storedKey == storageKey); ++probes) {
+        if (probes == _tableSize || probes == hash_table_type::max_probe_length_v) {
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return HashTableT::sentinel_v;
+        }
+        hashedentry = next_slot(hashedentry);
+        storedKey = atomicKeyCAS(hashedentry, storageKey);
       }
-      if (storedKey == key_sentinel_v) {
-        auto localno = (value_t)atomic_add(exectag, (unsigned_value_t *)_cnt, (unsigned_value_t)1);
+      /// an erased key is brought back by whoever turns its tombstone into a fresh slot first
+      if (storedKey == storage_key_sentinel_v
+          || (_table.indices[hashedentry] == tombstone_v
+              && atomic_cas(exectag, &_table.indices[hashedentry], tombstone_v,
+                            HashTableT::sentinel_v)
+                     == tombstone_v)) {
+        /// the count never exceeds the room in _activeKeys
+        value_t localno = *_cnt;
+        for (value_t cnt; localno < _tableSize; localno = cnt)
+          if ((cnt = atomic_cas(exectag, _cnt, localno, localno + 1)) == localno) break;
+        if (localno >= _tableSize) {
+          /// release the slot as a tombstone, which keeps the probe chains through it intact
+          /// and lets later insertions of this key overflow (and be counted) again
+          _table.indices[hashedentry] = tombstone_v;
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return HashTableT::sentinel_v;
+        }
         _table.indices[hashedentry] = localno;
         _activeKeys[localno] = key;
-        if (localno >= _tableSize - 20)
-          printf("proximity!!! %d -> %d\n", (int)localno, (int)_tableSize);
         return localno;  ///< only the one that inserts returns the actual index
       }
       return HashTableT::sentinel_v;
@@ -419,18 +737,24 @@ namespace zs {
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     __forceinline__ __device__ bool insert(const VecInterface<VecT> &key, value_t id) noexcept {
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      key_t storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
-      for (; !(storedKey == key_sentinel_v || storedKey == key);) {
-        hashedentry = (hashedentry + 127) % _tableSize;
-        storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
+      const storage_key_t storageKey = hash_table_type::pack_key(key);
+      value_t hashedentry = initial_slot(key);
+      storage_key_t storedKey = atomicKeyCAS(hashedentry, storageKey);
+      for (value_t probes = 1;
+           !(storedKey == storage_key_sentinel_v || storedKey == storageKey); ++probes) {
+        if (probes == _tableSize || probes == hash_table_type::max_probe_length_v) {
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return false;
+        }
+        hashedentry = next_slot(hashedentry);
+        storedKey = atomicKeyCAS(hashedentry, storageKey);
       }
-      if (storedKey == key_sentinel_v) {
+      if (storedKey == storage_key_sentinel_v) {
         _table.indices[hashedentry] = id;
         return true;
       }
-      return false;
+      return _table.indices[hashedentry] == tombstone_v
+             && atomic_cas(exectag, &_table.indices[hashedentry], tombstone_v, id) == tombstone_v;
     }
 #endif
     template <typename VecT, execspace_e S = space, bool V = is_const_structure,
@@ -438,18 +762,24 @@ namespace zs {
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     inline bool insert(const VecInterface<VecT> &key, value_t id) {
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      key_t storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
-      for (; !(storedKey == key_sentinel_v || storedKey == key);) {
-        hashedentry = (hashedentry + 127) % _tableSize;
-        storedKey = atomicKeyCAS(&_table.status[hashedentry], &_table.keys[hashedentry], key);
+      const storage_key_t storageKey = hash_table_type::pack_key(key);
+      value_t hashedentry = initial_slot(key);
+      storage_key_t storedKey = atomicKeyCAS(hashedentry, storageKey);
+      for (value_t probes = 1;
+           !(storedKey == storage_key_sentinel_v || storedKey == storageKey); ++probes) {
+        if (probes == _tableSize || probes == hash_table_type::max_probe_length_v) {
+          atomic_add(exectag, (unsigned_value_t *)_overflowCnt, (unsigned_value_t)1);
+          return false;
+        }
+        hashedentry = next_slot(hashedentry);
+        storedKey = atomicKeyCAS(hashedentry, storageKey);
       }
-      if (storedKey == key_sentinel_v) {
+      if (storedKey == storage_key_sentinel_v) {
         _table.indices[hashedentry] = id;
         return true;
       }
-      return false;
+      return _table.indices[hashedentry] == tombstone_v
+             && atomic_cas(exectag, &_table.indices[hashedentry], tombstone_v, id) == tombstone_v;
     }
 
     /// make sure no one else is inserting in the same time!
@@ -457,28 +787,51 @@ namespace zs {
               enable_if_all<VecT::dim == 1, VecT::extent == dim,
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     constexpr value_t query(const VecInterface<VecT> &key) const noexcept {
-      using namespace placeholders;
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      while (true) {
-        if (key == _table.keys[hashedentry]) return _table.indices[hashedentry];
-        if (_table.indices[hashedentry] == HashTableT::sentinel_v) return HashTableT::sentinel_v;
-        hashedentry += 127;  ///< search next entry
-        if (hashedentry > _tableSize) hashedentry = hashedentry % _tableSize;
-      }
+      const value_t hashedentry = entry(key);
+      if (hashedentry == HashTableT::sentinel_v) return HashTableT::sentinel_v;
+      const value_t id = _table.indices[hashedentry];
+      return id == tombstone_v ? HashTableT::sentinel_v : id;
     }
     template <typename VecT,
               enable_if_all<VecT::dim == 1, VecT::extent == dim,
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
     constexpr value_t entry(const VecInterface<VecT> &key) const noexcept {
       using namespace placeholders;
-      value_t hashedentry = (do_hash(key) % _tableSize + _tableSize) % _tableSize;
-      while (true) {
-        if (key == _table.keys[hashedentry]) return hashedentry;
+      const storage_key_t storageKey = hash_table_type::pack_key(key);
+      value_t hashedentry = initial_slot(key);
+      if constexpr (hash_table_type::bucketed_v) return bucket_entry(storageKey, hashedentry);
+      for (value_t probes = 0; probes != _tableSize; ++probes) {
+        if (storageKey == _table.keys[hashedentry]) return hashedentry;
         if (_table.indices[hashedentry] == HashTableT::sentinel_v) return HashTableT::sentinel_v;
         hashedentry += 127;  ///< search next entry
-        if (hashedentry > _tableSize) hashedentry = hashedentry % _tableSize;
+        if (hashedentry >= _tableSize) hashedentry = hashedentry % _tableSize;
       }
+      return HashTableT::sentinel_v;
+    }
+    /// the erased key keeps its slot and its _activeKeys entry until HashTable::compact
+#if defined(__CUDACC__)
+    template <typename VecT, execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V, VecT::dim == 1, VecT::extent == dim,
+                            std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
+    __forceinline__ __device__ bool erase(const VecInterface<VecT> &key) noexcept {
+      const value_t hashedentry = entry(key);
+      if (hashedentry == HashTableT::sentinel_v) return false;
+      const value_t id = _table.indices[hashedentry];
+      if (id < 0) return false;
+      return atomic_cas(exectag, &_table.indices[hashedentry], id, tombstone_v) == id;
     }
+#endif
+    template <typename VecT, execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V, VecT::dim == 1, VecT::extent == dim,
+                            std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
+    inline bool erase(const VecInterface<VecT> &key) {
+      const value_t hashedentry = entry(key);
+      if (hashedentry == HashTableT::sentinel_v) return false;
+      const value_t id = _table.indices[hashedentry];
+      if (id < 0) return false;
+      return atomic_cas(exectag, &_table.indices[hashedentry], id, tombstone_v) == id;
+    }
+
     template <execspace_e S = space, bool V = is_const_structure,
               enable_if_t<S == execspace_e::host && !V> = 0>
     void clear() {
@@ -486,11 +839,11 @@ namespace zs {
       // reset counter
       *_cnt = 0;
       // reset table
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
       for (value_t entry = 0; entry < _tableSize; ++entry) {
-        _table.keys[entry] = key_sentinel_v;
+        _table.keys[entry] = storage_key_sentinel_v;
         _table.indices[entry] = HashTableT::sentinel_v;
-        _table.status[entry] = HashTableT::status_sentinel_v;
+        if constexpr (!hash_table_type::packed_key_v)
+          _table.status[entry] = HashTableT::status_sentinel_v;
       }
     }
 
@@ -500,6 +853,7 @@ namespace zs {
     conditional_t<is_const_structure, const key_t *, key_t *> _activeKeys{nullptr};
     value_t _tableSize{0};  // constness makes non-trivial
     conditional_t<is_const_structure, const value_t *, value_t *> _cnt{nullptr};
+    conditional_t<is_const_structure, const value_t *, value_t *> _overflowCnt{nullptr};
 
   protected:
     template <typename VecT,
@@ -510,75 +864,129 @@ namespace zs {
       for (int d = 1; d < HashTableT::dim; ++d) hash_combine(ret, key[d]);
       return static_cast<value_t>(ret);
     }
-#if defined(__CUDACC__)
-    template <typename VecT, execspace_e S = space, bool V = is_const_structure,
-              enable_if_all<S == execspace_e::cuda, !V, VecT::dim == 1, VecT::extent == dim,
+    template <typename VecT,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim,
                             std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
-    __forceinline__ __device__ key_t atomicKeyCAS(status_t *lock, volatile key_t *const dest,
-                                                  const VecInterface<VecT> &val) noexcept {
+    constexpr value_t initial_slot(const VecInterface<VecT> &key) const noexcept {
+      /// bucketed tables start at the head of a bucket, their size being a power of 2. the hash
+      /// is mixed since linear probing suffers from clustering of nearby coordinates
+      if constexpr (hash_table_type::bucketed_v)
+        return (value_t)(hash((u64)do_hash(key)) & (u64)(_tableSize - 1)
+                         & ~(u64)(hash_table_type::bucket_size_v - 1));
+      else
+        return (do_hash(key) % _tableSize + _tableSize) % _tableSize;
+    }
+    constexpr value_t next_slot(value_t entry) const noexcept {
+      if constexpr (hash_table_type::bucketed_v)
+        return (entry + 1) & (_tableSize - 1);
+      else
+        return (entry + 127) % _tableSize;
+    }
+    /// slots of a bucket are filled in order, thus a vacant slot ends the search. the whole
+    /// bucket is compared at once so that the comparison of packed keys gets vectorized
+    constexpr value_t bucket_entry(const storage_key_t &storageKey,
+                                   value_t bucketHead) const noexcept {
+      constexpr int bucket_size_v = hash_table_type::bucket_size_v;
+      for (value_t probes = 0; probes < _tableSize; probes += bucket_size_v) {
+        const storage_key_t *bucket = _table.keys + bucketHead;
+        int found = -1;
+        bool vacant = false;
+        for (int j = 0; j != bucket_size_v; ++j) {
+          if (bucket[j] == storageKey) found = j;
+          vacant |= bucket[j] == storage_key_sentinel_v;
+        }
+        if (found != -1) return bucketHead + found;
+        if (vacant) return HashTableT::sentinel_v;
+        bucketHead = (bucketHead + bucket_size_v) & (_tableSize - 1);
+      }
+      return HashTableT::sentinel_v;
+    }
+#if defined(__CUDACC__)
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S == execspace_e::cuda, !V> = 0>
+    __forceinline__ __device__ storage_key_t atomicKeyCAS(value_t entry,
+                                                          const storage_key_t &val) noexcept {
       constexpr auto execTag = wrapv<S>{};
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      key_t return_val{};
-      int done = 0;
-      unsigned int mask = active_mask(execTag);             // __activemask();
-      unsigned int active = ballot_sync(execTag, mask, 1);  //__ballot_sync(mask, 1);
-      unsigned int done_active = 0;
-      while (active != done_active) {
-        if (!done) {
-          if (atomic_cas(execTag, lock, HashTableT::status_sentinel_v, (status_t)0)
-              == HashTableT::status_sentinel_v) {
-            thread_fence(execTag);  // __threadfence();
-            /// <deprecating volatile - JF Bastien - CppCon2019>
-            /// access non-volatile using volatile semantics
-            /// use cast
-            (void)(return_val = *const_cast<key_t *>(dest));
-            /// https://github.com/kokkos/kokkos/commit/2fd9fb04a94ecba29a04a0894c99e1d9c16ad66a
-            if (return_val == key_sentinel_v) {
-              for (int d = 0; d < dim; ++d) (void)(dest->data()[d] = val[d]);
-              // (void)(*dest = val);
+      /// packed keys are claimed by a single word-sized CAS, skipped when already taken
+      if constexpr (hash_table_type::packed_key_v) {
+        if (auto storedKey = _table.keys[entry]; storedKey != storage_key_sentinel_v)
+          return storedKey;
+        return atomic_cas(execTag, &_table.keys[entry], storage_key_sentinel_v, val);
+      }
+      else {
+        status_t *lock = &_table.status[entry];
+        volatile key_t *const dest = &_table.keys[entry];
+        key_t return_val{};
+        int done = 0;
+        unsigned int mask = active_mask(execTag);             // __activemask();
+        unsigned int active = ballot_sync(execTag, mask, 1);  //__ballot_sync(mask, 1);
+        unsigned int done_active = 0;
+        while (active != done_active) {
+          if (!done) {
+            if (atomic_cas(execTag, lock, HashTableT::status_sentinel_v, (status_t)0)
+                == HashTableT::status_sentinel_v) {
+              thread_fence(execTag);  // __threadfence();
+              /// <deprecating volatile - JF Bastien - CppCon2019>
+              /// access non-volatile using volatile semantics
+              /// use cast
+              (void)(return_val = *const_cast<key_t *>(dest));
+              /// https://github.com/kokkos/kokkos/commit/2fd9fb04a94ecba29a04a0894c99e1d9c16ad66a
+              if (return_val == storage_key_sentinel_v) {
+                for (int d = 0; d < dim; ++d) (void)(dest->data()[d] = val[d]);
+                // (void)(*dest = val);
+              }
+              thread_fence(execTag);  // __threadfence();
+              atomic_exch(execTag, lock, HashTableT::status_sentinel_v);
+              done = 1;
             }
-            thread_fence(execTag);  // __threadfence();
-            atomic_exch(execTag, lock, HashTableT::status_sentinel_v);
-            done = 1;
           }
+          done_active = ballot_sync(execTag, mask, done);  //__ballot_sync(mask, done);
         }
-        done_active = ballot_sync(execTag, mask, done);  //__ballot_sync(mask, done);
+        return return_val;
       }
-      return return_val;
     }
 #endif
-    template <typename VecT, execspace_e S = space, bool V = is_const_structure,
-              enable_if_all<S != execspace_e::cuda, !V, VecT::dim == 1, VecT::extent == dim,
-                            std::is_convertible_v<typename VecT::value_type, Tn>> = 0>
-    inline key_t atomicKeyCAS(status_t *lock, volatile key_t *const dest,
-                              const VecInterface<VecT> &val) {
+    template <execspace_e S = space, bool V = is_const_structure,
+              enable_if_all<S != execspace_e::cuda, !V> = 0>
+    inline storage_key_t atomicKeyCAS(value_t entry, const storage_key_t &val) {
       constexpr auto execTag = wrapv<S>{};
       using namespace placeholders;
-      constexpr key_t key_sentinel_v = key_t::uniform(HashTableT::key_scalar_sentinel_v);
-      key_t return_val{};
-      bool done = false;
-      while (!done) {
-        if (atomic_cas(execTag, lock, HashTableT::status_sentinel_v, (status_t)0)
-            == HashTableT::status_sentinel_v) {
-          (void)(return_val = *const_cast<key_t *>(dest));
-          if (return_val == key_sentinel_v)
-            for (int d = 0; d < dim; ++d) (void)(dest->data()[d] = val[d]);
-          atomic_exch(execTag, lock, HashTableT::status_sentinel_v);
-          done = true;
+      /// packed keys are claimed by a single word-sized CAS, skipped when already taken
+      if constexpr (hash_table_type::packed_key_v) {
+        if (auto storedKey = _table.keys[entry]; storedKey != storage_key_sentinel_v)
+          return storedKey;
+        return atomic_cas(execTag, &_table.keys[entry], storage_key_sentinel_v, val);
+      }
+      else {
+        status_t *lock = &_table.status[entry];
+        volatile key_t *const dest = &_table.keys[entry];
+        key_t return_val{};
+        bool done = false;
+        while (!done) {
+          if (atomic_cas(execTag, lock, HashTableT::status_sentinel_v, (status_t)0)
+              == HashTableT::status_sentinel_v) {
+            (void)(return_val = *const_cast<key_t *>(dest));
+            if (return_val == storage_key_sentinel_v)
+              for (int d = 0; d < dim; ++d) (void)(dest->data()[d] = val[d]);
+            atomic_exch(execTag, lock, HashTableT::status_sentinel_v);
+            done = true;
+          }
         }
+        return return_val;
       }
-      return return_val;
     }
   };
 
-  template <execspace_e ExecSpace, typename Tn, int dim, typename Index, typename Allocator>
-  constexpr decltype(auto) proxy(HashTable<Tn, dim, Index, Allocator> &table) {
-    return HashTableView<ExecSpace, HashTable<Tn, dim, Index, Allocator>>{table};
+  template <execspace_e ExecSpace, typename Tn, int dim, typename Index, typename Allocator,
+            hash_layout_e Layout>
+  constexpr decltype(auto) proxy(HashTable<Tn, dim, Index, Allocator, Layout> &table) {
+    return HashTableView<ExecSpace, HashTable<Tn, dim, Index, Allocator, Layout>>{table};
   }
-  template <execspace_e ExecSpace, typename Tn, int dim, typename Index, typename Allocator>
-  constexpr decltype(auto) proxy(const HashTable<Tn, dim, Index, Allocator> &table) {
-    return HashTableView<ExecSpace, const HashTable<Tn, dim, Index, Allocator>>{table};
+  template <execspace_e ExecSpace, typename Tn, int dim, typename Index, typename Allocator,
+            hash_layout_e Layout>
+  constexpr decltype(auto) proxy(const HashTable<Tn, dim, Index, Allocator, Layout> &table) {
+    return HashTableView<ExecSpace, const HashTable<Tn, dim, Index, Allocator, Layout>>{table};
   }
 
 }  // namespace zs
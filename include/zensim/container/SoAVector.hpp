@@ -0,0 +1,464 @@
+#pragma once
+#include "Vector.hpp"
+#include "zensim/math/Vec.h"
+#include "zensim/memory/Allocator.h"
+#include "zensim/resource/Resource.h"
+#include "zensim/types/SmallVector.hpp"
+
+namespace zs {
+
+  /// structure-of-arrays with runtime named properties (see PropertyTag) in a single allocation
+  /// every channel is a contiguous column starting on a column_alignment boundary, thus a kernel
+  /// streaming a few channels touches nothing else and the view exposes raw column pointers
+  template <typename T, typename AllocatorT = ZSPmrAllocator<>> struct SoAVector {
+    static_assert(is_zs_allocator<AllocatorT>::value,
+                  "SoAVector only works with zspmrallocator for now.");
+    static_assert(!is_virtual_zs_allocator<AllocatorT>::value,
+                  "SoAVector relayouts its columns upon growth, thus no virtual allocator.");
+    static_assert(is_same_v<T, remove_cvref_t<T>>, "T is not cvref-unqualified type!");
+    static_assert(std::is_default_constructible_v<T> && std::is_trivially_copyable_v<T>,
+                  "element is not default-constructible or trivially-copyable!");
+
+    using value_type = T;
+    using allocator_type = AllocatorT;
+    using size_type = std::size_t;
+    using difference_type = std::make_signed_t<size_type>;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using channel_counter_type = int;
+
+    static constexpr size_type column_alignment
+        = std::max((size_type)128, std::alignment_of_v<value_type>);
+    static_assert(column_alignment % sizeof(value_type) == 0,
+                  "element size should divide the column alignment!");
+    static constexpr size_type column_granularity = column_alignment / sizeof(value_type);
+
+    static_assert(
+        std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+            && std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value
+            && std::allocator_traits<allocator_type>::propagate_on_container_swap::value,
+        "allocator should propagate on copy, move and swap (for impl simplicity)!");
+
+    /// elements per column, padded so that every column starts aligned
+    static constexpr size_type column_stride(size_type elementCount) noexcept {
+      return (elementCount + column_granularity - 1) / column_granularity * column_granularity;
+    }
+
+    constexpr decltype(auto) memoryLocation() const noexcept { return _allocator.location; }
+    constexpr ProcID devid() const noexcept { return memoryLocation().devid(); }
+    constexpr memsrc_e memspace() const noexcept { return memoryLocation().memspace(); }
+    decltype(auto) get_allocator() const noexcept { return _allocator; }
+    decltype(auto) get_default_allocator(memsrc_e mre, ProcID devid) const {
+      return get_memory_source(mre, devid);
+    }
+    pointer allocate(std::size_t bytes) {
+      return (pointer)_allocator.allocate(bytes, column_alignment);
+    }
+
+    SoAVector(const allocator_type &allocator, const std::vector<PropertyTag> &channelTags,
+              size_type count = 0)
+        : _allocator{allocator},
+          _base{nullptr},
+          _tags{channelTags},
+          _size{count},
+          _capacity{column_stride(count)},
+          _numChannels{numTotalChannels(channelTags)} {
+      const auto N = numProperties();
+      _base = allocate(sizeof(value_type) * numChannels() * capacity());
+      {
+        auto tagNames = Vector<SmallString, allocator_type>{static_cast<std::size_t>(N)};
+        auto tagSizes = Vector<channel_counter_type, allocator_type>{static_cast<std::size_t>(N)};
+        auto tagOffsets = Vector<channel_counter_type, allocator_type>{static_cast<std::size_t>(N)};
+        channel_counter_type curOffset = 0;
+        for (auto &&[name, size, offset, src] : zip(tagNames, tagSizes, tagOffsets, channelTags)) {
+          name = src.name;
+          size = src.numChannels;
+          offset = curOffset;
+          curOffset += size;
+        }
+        _tagNames = tagNames.clone(_allocator);
+        _tagSizes = tagSizes.clone(_allocator);
+        _tagOffsets = tagOffsets.clone(_allocator);
+      }
+    }
+    SoAVector(const std::vector<PropertyTag> &channelTags, size_type count = 0,
+              memsrc_e mre = memsrc_e::host, ProcID devid = -1)
+        : SoAVector{get_default_allocator(mre, devid), channelTags, count} {}
+    SoAVector(channel_counter_type numChns, size_type count = 0, memsrc_e mre = memsrc_e::host,
+              ProcID devid = -1)
+        : SoAVector{get_default_allocator(mre, devid), {{"unnamed", numChns}}, count} {}
+    SoAVector(memsrc_e mre = memsrc_e::host, ProcID devid = -1)
+        : SoAVector{get_default_allocator(mre, devid), {{"unnamed", 1}}, 0} {}
+
+    ~SoAVector() {
+      if (_base && capacity() > 0)
+        _allocator.deallocate(_base, sizeof(value_type) * numChannels() * capacity(),
+                              column_alignment);
+    }
+
+    static auto numTotalChannels(const std::vector<PropertyTag> &tags) {
+      channel_counter_type cnt = 0;
+      for (std::size_t i = 0; i != tags.size(); ++i) cnt += tags[i].numChannels;
+      return cnt;
+    }
+
+    /// capacity
+    constexpr size_type size() const noexcept { return _size; }
+    /// also the distance (in elements) between two adjacent columns
+    constexpr size_type capacity() const noexcept { return _capacity; }
+    constexpr channel_counter_type numChannels() const noexcept { return _numChannels; }
+    constexpr bool empty() noexcept { return size() == 0; }
+    constexpr const_pointer data() const noexcept { return _base; }
+    constexpr pointer data() noexcept { return _base; }
+    constexpr const_pointer column(channel_counter_type chn) const noexcept {
+      return _base + chn * capacity();
+    }
+    constexpr pointer column(channel_counter_type chn) noexcept { return _base + chn * capacity(); }
+
+    /// element access
+    constexpr reference operator[](
+        const std::tuple<channel_counter_type, size_type> index) noexcept {
+      const auto [chn, idx] = index;
+      return *(column(chn) + idx);
+    }
+    constexpr conditional_t<std::is_fundamental_v<value_type>, value_type, const_reference>
+    operator[](const std::tuple<channel_counter_type, size_type> index) const noexcept {
+      const auto [chn, idx] = index;
+      return *(column(chn) + idx);
+    }
+    /// ctor, assignment operator
+    SoAVector(const SoAVector &o)
+        : _allocator{o._allocator},
+          _base{allocate(sizeof(value_type) * o.numChannels() * o.capacity())},
+          _tags{o._tags},
+          _tagNames{o._tagNames},
+          _tagSizes{o._tagSizes},
+          _tagOffsets{o._tagOffsets},
+          _size{o.size()},
+          _capacity{o.capacity()},
+          _numChannels{o.numChannels()} {
+      if (capacity() > 0)
+        Resource::copy(MemoryEntity{memoryLocation(), (void *)data()},
+                       MemoryEntity{o.memoryLocation(), (void *)o.data()},
+                       sizeof(value_type) * o.numChannels() * o.capacity());
+    }
+    SoAVector &operator=(const SoAVector &o) {
+      if (this == &o) return *this;
+      SoAVector tmp(o);
+      swap(tmp);
+      return *this;
+    }
+    SoAVector clone(const allocator_type &allocator) const {
+      SoAVector ret{allocator, _tags, size()};
+      ret.copy_columns(*this, size());
+      return ret;
+    }
+    SoAVector clone(const MemoryLocation &mloc) const {
+      return clone(get_default_allocator(mloc.memspace(), mloc.devid()));
+    }
+    /// assignment or destruction after std::move
+    /// leave the source object in a valid (default constructed) state
+    SoAVector(SoAVector &&o) noexcept {
+      const SoAVector defaultVector{};
+      _base = std::exchange(o._base, defaultVector._base);
+      _allocator = std::exchange(o._allocator, defaultVector._allocator);
+      _tags = std::exchange(o._tags, defaultVector._tags);
+      _tagNames = std::exchange(o._tagNames, defaultVector._tagNames);
+      _tagSizes = std::exchange(o._tagSizes, defaultVector._tagSizes);
+      _tagOffsets = std::exchange(o._tagOffsets, defaultVector._tagOffsets);
+      _size = std::exchange(o._size, defaultVector.size());
+      _capacity = std::exchange(o._capacity, defaultVector.capacity());
+      _numChannels = std::exchange(o._numChannels, defaultVector.numChannels());
+    }
+    /// make move-assignment safe for self-assignment
+    SoAVector &operator=(SoAVector &&o) noexcept {
+      if (this == &o) return *this;
+      SoAVector tmp(std::move(o));
+      swap(tmp);
+      return *this;
+    }
+    void swap(SoAVector &o) noexcept {
+      std::swap(_base, o._base);
+      std::swap(_allocator, o._allocator);
+      std::swap(_tags, o._tags);
+      std::swap(_tagNames, o._tagNames);
+      std::swap(_tagSizes, o._tagSizes);
+      std::swap(_tagOffsets, o._tagOffsets);
+      std::swap(_size, o._size);
+      std::swap(_capacity, o._capacity);
+      std::swap(_numChannels, o._numChannels);
+    }
+    friend void swap(SoAVector &a, SoAVector &b) { a.swap(b); }
+
+    void clear() { *this = SoAVector{_allocator, _tags, 0}; }
+    void reset(int ch) {
+      Resource::memset(MemoryEntity{memoryLocation(), (void *)data()}, ch,
+                       sizeof(value_type) * numChannels() * capacity());
+    }
+    void resize(size_type newSize) {
+      if (newSize > capacity()) {
+        /// columns are relocated one by one since the stride changes
+        SoAVector tmp{_allocator, _tags, geometric_size_growth(newSize)};
+        tmp.copy_columns(*this, size());
+        swap(tmp);
+      }
+      _size = newSize;
+    }
+
+    constexpr size_type geometric_size_growth(size_type newSize,
+                                              size_type capacity) const noexcept {
+      size_type geometricSize = capacity;
+      geometricSize = geometricSize + geometricSize / 2;
+      if (newSize > geometricSize) return column_stride(newSize);
+      return column_stride(geometricSize);
+    }
+    constexpr size_type geometric_size_growth(size_type newSize) const noexcept {
+      return geometric_size_growth(newSize, capacity());
+    }
+
+    constexpr channel_counter_type numProperties() const noexcept { return _tags.size(); }
+
+    bool hasProperty(const SmallString &str) const {
+      for (auto &&tag : _tags)
+        if (str == tag.name) return true;
+      return false;
+    }
+    constexpr const SmallString *tagNameHandle() const noexcept { return _tagNames.data(); }
+    constexpr const channel_counter_type *tagSizeHandle() const noexcept {
+      return _tagSizes.data();
+    }
+    constexpr const channel_counter_type *tagOffsetHandle() const noexcept {
+      return _tagOffsets.data();
+    }
+    constexpr channel_counter_type getChannelSize(const SmallString &str) const {
+      for (auto &&tag : _tags)
+        if (str == tag.name) return tag.numChannels;
+      return 0;
+    }
+    constexpr channel_counter_type getChannelOffset(const SmallString &str) const {
+      channel_counter_type offset = 0;
+      for (auto &&tag : _tags) {
+        if (str == tag.name) return offset;
+        offset += tag.numChannels;
+      }
+      return 0;
+    }
+    constexpr PropertyTag getPropertyTag(std::size_t i = 0) const { return _tags[i]; }
+    constexpr const auto &getPropertyTags() const { return _tags; }
+
+  protected:
+    /// copies the first count elements of every column of o, whose layout may differ
+    void copy_columns(const SoAVector &o, size_type count) {
+      if (count == 0) return;
+      for (channel_counter_type chn = 0; chn != numChannels(); ++chn)
+        Resource::copy(MemoryEntity{memoryLocation(), (void *)column(chn)},
+                       MemoryEntity{o.memoryLocation(), (void *)o.column(chn)},
+                       sizeof(value_type) * count);
+    }
+
+    allocator_type _allocator{};
+    pointer _base{nullptr};
+    std::vector<PropertyTag> _tags{};  // on host
+    /// for proxy use
+    Vector<SmallString, allocator_type> _tagNames{};
+    Vector<channel_counter_type, allocator_type> _tagSizes{};
+    Vector<channel_counter_type, allocator_type> _tagOffsets{};
+    size_type _size{0}, _capacity{0};  // element size
+    channel_counter_type _numChannels{1};
+  };
+
+  template <execspace_e, typename SoAVectorT, typename = void> struct SoAVectorUnnamedView {
+    static constexpr bool is_const_structure = std::is_const_v<SoAVectorT>;
+    using soa_vector_type = std::remove_const_t<SoAVectorT>;
+    using const_soa_vector_type = std::add_const_t<soa_vector_type>;
+    using pointer = typename soa_vector_type::pointer;
+    using const_pointer = typename soa_vector_type::const_pointer;
+    using value_type = typename soa_vector_type::value_type;
+    using reference = typename soa_vector_type::reference;
+    using const_reference = typename soa_vector_type::const_reference;
+    using size_type = typename soa_vector_type::size_type;
+    using difference_type = typename soa_vector_type::difference_type;
+    using channel_counter_type = typename soa_vector_type::channel_counter_type;
+
+    SoAVectorUnnamedView() noexcept = default;
+    explicit constexpr SoAVectorUnnamedView(SoAVectorT &soavector)
+        : _vector{soavector.data()},
+          _vectorSize{soavector.size()},
+          _stride{soavector.capacity()},
+          _numChannels{soavector.numChannels()} {}
+
+    template <bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr reference operator()(const channel_counter_type chn, const size_type i) noexcept {
+      return *(_vector + chn * _stride + i);
+    }
+    constexpr const_reference operator()(const channel_counter_type chn,
+                                         const size_type i) const noexcept {
+      return *(_vector + chn * _stride + i);
+    }
+    /// raw column access, contiguous over the whole vector
+    template <bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr pointer column(const channel_counter_type chn) noexcept {
+      return _vector + chn * _stride;
+    }
+    constexpr const_pointer column(const channel_counter_type chn) const noexcept {
+      return _vector + chn * _stride;
+    }
+
+    template <auto... Ns>
+    constexpr auto pack(channel_counter_type chn, const size_type i) const noexcept {
+      using RetT = vec<value_type, Ns...>;
+      RetT ret{};
+      size_type offset = chn * _stride + i;
+      for (channel_counter_type d = 0; d != RetT::extent; ++d, offset += _stride)
+        ret.val(d) = *(_vector + offset);
+      return ret;
+    }
+    template <std::size_t... Is, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr auto tuple_impl(const channel_counter_type chnOffset, const size_type i,
+                              index_seq<Is...>) noexcept {
+      return zs::tie(*(_vector + (chnOffset + Is) * _stride + i)...);
+    }
+    template <std::size_t... Is> constexpr auto tuple_impl(const channel_counter_type chnOffset,
+                                                           const size_type i,
+                                                           index_seq<Is...>) const noexcept {
+      return zs::tie(*(_vector + (chnOffset + Is) * _stride + i)...);
+    }
+    template <auto d, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr auto tuple(const channel_counter_type chn, const size_type i) noexcept {
+      return tuple_impl(chn, i, std::make_index_sequence<d>{});
+    }
+    template <auto d>
+    constexpr auto tuple(const channel_counter_type chn, const size_type i) const noexcept {
+      return tuple_impl(chn, i, std::make_index_sequence<d>{});
+    }
+
+    constexpr size_type size() const noexcept { return _vectorSize; }
+    constexpr channel_counter_type numChannels() const noexcept { return _numChannels; }
+
+    conditional_t<is_const_structure, const_pointer, pointer> _vector{nullptr};
+    size_type _vectorSize{0}, _stride{0};
+    channel_counter_type _numChannels{0};
+  };
+
+  template <execspace_e ExecSpace, typename T, typename Allocator>
+  constexpr decltype(auto) proxy(const SoAVector<T, Allocator> &vec) {
+    return SoAVectorUnnamedView<ExecSpace, const SoAVector<T, Allocator>>{vec};
+  }
+  template <execspace_e ExecSpace, typename T, typename Allocator>
+  constexpr decltype(auto) proxy(SoAVector<T, Allocator> &vec) {
+    return SoAVectorUnnamedView<ExecSpace, SoAVector<T, Allocator>>{vec};
+  }
+
+  template <execspace_e Space, typename SoAVectorT, typename = void> struct SoAVectorView
+      : SoAVectorUnnamedView<Space, SoAVectorT> {
+    using base_t = SoAVectorUnnamedView<Space, SoAVectorT>;
+
+    static constexpr bool is_const_structure = base_t::is_const_structure;
+    using pointer = typename base_t::pointer;
+    using const_pointer = typename base_t::const_pointer;
+    using value_type = typename base_t::value_type;
+    using reference = typename base_t::reference;
+    using const_reference = typename base_t::const_reference;
+    using size_type = typename base_t::size_type;
+    using difference_type = typename base_t::difference_type;
+    using channel_counter_type = typename base_t::channel_counter_type;
+
+    SoAVectorView() noexcept = default;
+    explicit constexpr SoAVectorView(const std::vector<SmallString> &tagNames,
+                                     SoAVectorT &soavector)
+        : base_t{soavector},
+          _tagNames{soavector.tagNameHandle()},
+          _tagOffsets{soavector.tagOffsetHandle()},
+          _tagSizes{soavector.tagSizeHandle()},
+          _N{static_cast<channel_counter_type>(soavector.numProperties())} {}
+
+    constexpr auto numProperties() const noexcept { return _N; }
+    constexpr auto propertyIndex(const SmallString &propName) const noexcept {
+      channel_counter_type i = 0;
+      for (; i != _N; ++i)
+        if (_tagNames[i] == propName) break;
+      return i;
+    }
+    constexpr auto propertySize(const SmallString &propName) const noexcept {
+      return _tagSizes[propertyIndex(propName)];
+    }
+    constexpr auto propertyOffset(const SmallString &propName) const noexcept {
+      return _tagOffsets[propertyIndex(propName)];
+    }
+    constexpr bool hasProperty(const SmallString &propName) const noexcept {
+      return propertyIndex(propName) != _N;
+    }
+
+    using base_t::operator();
+    using base_t::column;
+    using base_t::pack;
+    using base_t::tuple;
+    template <bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr reference operator()(const SmallString &propName, const channel_counter_type chn,
+                                   const size_type i) noexcept {
+      return static_cast<base_t &>(*this)(propertyOffset(propName) + chn, i);
+    }
+    constexpr const_reference operator()(const SmallString &propName,
+                                         const channel_counter_type chn,
+                                         const size_type i) const noexcept {
+      return static_cast<const base_t &>(*this)(propertyOffset(propName) + chn, i);
+    }
+    template <bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr reference operator()(const SmallString &propName, const size_type i) noexcept {
+      return static_cast<base_t &>(*this)(propertyOffset(propName), i);
+    }
+    constexpr const_reference operator()(const SmallString &propName,
+                                         const size_type i) const noexcept {
+      return static_cast<const base_t &>(*this)(propertyOffset(propName), i);
+    }
+    /// resolve the name once outside the loop, then stream through the column
+    template <bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr pointer column(const SmallString &propName,
+                             const channel_counter_type chn = 0) noexcept {
+      return static_cast<base_t &>(*this).column(propertyOffset(propName) + chn);
+    }
+    constexpr const_pointer column(const SmallString &propName,
+                                   const channel_counter_type chn = 0) const noexcept {
+      return static_cast<const base_t &>(*this).column(propertyOffset(propName) + chn);
+    }
+    template <auto... Ns>
+    constexpr auto pack(const SmallString &propName, const size_type i) const noexcept {
+      return static_cast<const base_t &>(*this).template pack<Ns...>(propertyOffset(propName), i);
+    }
+    template <auto d, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr auto tuple(const SmallString &propName, const size_type i) noexcept {
+      return static_cast<base_t &>(*this).template tuple<d>(propertyOffset(propName), i);
+    }
+    template <auto d>
+    constexpr auto tuple(const SmallString &propName, const size_type i) const noexcept {
+      return static_cast<const base_t &>(*this).template tuple<d>(propertyOffset(propName), i);
+    }
+
+    const SmallString *_tagNames{nullptr};
+    const channel_counter_type *_tagOffsets{nullptr};
+    const channel_counter_type *_tagSizes{nullptr};
+    channel_counter_type _N{0};
+  };
+
+  template <execspace_e ExecSpace, typename T, typename Allocator>
+  constexpr decltype(auto) proxy(const std::vector<SmallString> &tagNames,
+                                 const SoAVector<T, Allocator> &vec) {
+    for (auto &&tag : tagNames)
+      if (!vec.hasProperty(tag))
+        throw std::runtime_error(
+            fmt::format("soavector attribute [\"{}\"] not exists", (std::string)tag));
+    return SoAVectorView<ExecSpace, const SoAVector<T, Allocator>>{tagNames, vec};
+  }
+  template <execspace_e ExecSpace, typename T, typename Allocator>
+  constexpr decltype(auto) proxy(const std::vector<SmallString> &tagNames,
+                                 SoAVector<T, Allocator> &vec) {
+    for (auto &&tag : tagNames)
+      if (!vec.hasProperty(tag))
+        throw std::runtime_error(
+            fmt::format("soavector attribute [\"{}\"] not exists", (std::string)tag));
+    return SoAVectorView<ExecSpace, SoAVector<T, Allocator>>{tagNames, vec};
+  }
+
+}  // namespace zs
@@ -51,7 +51,9 @@ namespace zs {
     pointer allocate(std::size_t bytes) {
       /// virtual memory way
       if constexpr (is_virtual_zs_allocator<allocator_type>::value) {
-        _allocator.commit(0, bytes);
+        if (!_allocator.commit(0, bytes))
+          throw std::runtime_error(
+              fmt::format("unable to commit {} bytes of the virtual address range", bytes));
         return (pointer)_allocator.address(0);
       }
       /// conventional way
@@ -270,10 +272,11 @@ namespace zs {
       if (newSize > oldSize) {
         const auto oldCapacity = capacity();
         if (newSize > oldCapacity) {
-          /// virtual memory way
+          /// virtual memory way, grows in place
           if constexpr (is_virtual_zs_allocator<allocator_type>::value) {
-            _capacity = count_tiles(geometric_size_growth(newSize)) * lane_width;
-            _allocator.commit(capacity() * numChannels() * sizeof(value_type));
+            const auto newCapacity = count_tiles(geometric_size_growth(newSize)) * lane_width;
+            allocate(newCapacity * numChannels() * sizeof(value_type));
+            _capacity = newCapacity;
             _size = newSize;
           }
           /// conventional way
@@ -306,6 +309,14 @@ namespace zs {
     }
     template <typename Policy>
     void append_channels(Policy &&, const std::vector<PropertyTag> &tags);
+    /// reorders all channels at once such that element i becomes the previous element order[i]
+    template <typename Policy, typename IndexT, typename IndexAllocator>
+    void permute(Policy &&, const Vector<IndexT, IndexAllocator> &order);
+    /// stable removal of the elements whose index satisfies pred(i), returns the count
+    template <typename Policy, typename Predicate>
+    size_type erase_if(Policy &&policy, Predicate &&pred);
+    /// keeps (in order) the elements left unerased by mark_erasure
+    template <typename Policy> void compact(Policy &&policy, const ErasureMarks &kept);
 
     constexpr channel_counter_type numProperties() const noexcept { return _tags.size(); }
 
@@ -409,6 +420,73 @@ namespace zs {
     policy(range(s), TileVectorCopy{proxy<space>(*this), proxy<space>(tmp)});
     *this = std::move(tmp);
   }
+  template <typename TileVectorView, typename OrderView> struct TileVectorPermute {
+    using size_type = typename TileVectorView::size_type;
+    using channel_counter_type = typename TileVectorView::channel_counter_type;
+    static constexpr auto lane_width = TileVectorView::lane_width;
+    TileVectorPermute(TileVectorView src, TileVectorView dst, OrderView order)
+        : src{src}, dst{dst}, order{order} {}
+    /// a whole destination tile at a time, channel by channel, thus writes are contiguous
+    constexpr void operator()(size_type tileid) {
+      const auto base = tileid * lane_width;
+      const size_type numLanes
+          = base + lane_width <= dst.size() ? lane_width : dst.size() - base;
+      auto tile = dst.tile(tileid);
+      const auto nchns = dst.numChannels();
+      for (channel_counter_type chn = 0; chn != nchns; ++chn)
+        for (size_type l = 0; l != numLanes; ++l) tile(chn, l) = src(chn, order[base + l]);
+    }
+    TileVectorView src, dst;
+    OrderView order;
+  };
+  template <typename T, std::size_t Length, typename Allocator>
+  template <typename Policy, typename IndexT, typename IndexAllocator>
+  void TileVector<T, Length, Allocator>::permute(Policy &&policy,
+                                                  const Vector<IndexT, IndexAllocator> &order) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    if (order.size() != size())
+      throw std::runtime_error(
+          fmt::format("permute: the order has [{}] entries whereas the tilevector has [{}].",
+                      order.size(), size()));
+    TileVector tmp{get_allocator(), getPropertyTags(), size()};
+    policy(range(numTiles()),
+           TileVectorPermute{proxy<space>(*this), proxy<space>(tmp), proxy<space>(order)});
+    *this = std::move(tmp);
+  }
+  template <typename TileVectorView, typename MarkView, typename OffsetView>
+  struct TileVectorCompact {
+    using size_type = typename TileVectorView::size_type;
+    using channel_counter_type = typename TileVectorView::channel_counter_type;
+    TileVectorCompact(TileVectorView src, TileVectorView dst, MarkView marks, OffsetView offsets)
+        : src{src}, dst{dst}, marks{marks}, offsets{offsets} {}
+    constexpr void operator()(size_type i) {
+      if (!marks[i]) return;
+      const auto dsti = offsets[i];
+      const auto nchns = src.numChannels();
+      for (channel_counter_type chn = 0; chn != nchns; ++chn) dst(chn, dsti) = src(chn, i);
+    }
+    TileVectorView src, dst;
+    MarkView marks;
+    OffsetView offsets;
+  };
+  template <typename T, std::size_t Length, typename Allocator> template <typename Policy>
+  void TileVector<T, Length, Allocator>::compact(Policy &&policy, const ErasureMarks &kept) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    if (kept.numKept == size()) return;
+    TileVector tmp{get_allocator(), getPropertyTags(), kept.numKept};
+    policy(range(size()), TileVectorCompact{proxy<space>(*this), proxy<space>(tmp),
+                                            proxy<space>(kept.marks), proxy<space>(kept.offsets)});
+    *this = std::move(tmp);
+  }
+  template <typename T, std::size_t Length, typename Allocator>
+  template <typename Policy, typename Predicate>
+  auto TileVector<T, Length, Allocator>::erase_if(Policy &&policy, Predicate &&pred)
+      -> size_type {
+    const auto n = size();
+    const auto kept = mark_erasure(policy, memoryLocation(), n, FWD(pred));
+    compact(policy, kept);
+    return n - kept.numKept;
+  }
   template <typename TileVectorView> struct TileVectorReset {
     using size_type = typename TileVectorView::size_type;
     using value_type = typename TileVectorView::value_type;
@@ -512,6 +590,30 @@ namespace zs {
             _vector + tileid * lane_width * _numChannels, lane_width, _numChannels};
     }
 
+    /// tile-granular access, the lane_width values of a channel are contiguous within a tile
+    /// thus lane-wise loops over them compile to packed simd loads/stores on host backends
+    template <bool V = is_const_structure, bool InTile = WithinTile, enable_if_all<!V, InTile> = 0>
+    constexpr pointer lane(const channel_counter_type chn) noexcept {
+      return _vector + chn * lane_width;
+    }
+    template <bool InTile = WithinTile, enable_if_t<InTile> = 0>
+    constexpr const_pointer lane(const channel_counter_type chn) const noexcept {
+      return _vector + chn * lane_width;
+    }
+    template <bool InTile = WithinTile, enable_if_t<InTile> = 0>
+    constexpr auto load(const channel_counter_type chn) const noexcept {
+      vec<value_type, (int)lane_width> ret{};
+      const auto src = lane(chn);
+      for (size_type l = 0; l != lane_width; ++l) ret.val(l) = src[l];
+      return ret;
+    }
+    template <typename VecT, bool V = is_const_structure, bool InTile = WithinTile,
+              enable_if_all<!V, InTile, VecT::dim == 1, VecT::extent == (int)lane_width> = 0>
+    constexpr void store(const channel_counter_type chn, const VecInterface<VecT> &v) noexcept {
+      const auto dst = lane(chn);
+      for (size_type l = 0; l != lane_width; ++l) dst[l] = v.val(l);
+    }
+
     template <auto... Ns>
     constexpr auto pack(channel_counter_type chn, const size_type i) const noexcept {
       using RetT = vec<value_type, Ns...>;
@@ -762,6 +864,19 @@ namespace zs {
           _N};
     }
 
+    using base_t::lane;
+    using base_t::load;
+    using base_t::store;
+    template <bool V = is_const_structure, bool InTile = WithinTile, enable_if_all<!V, InTile> = 0>
+    constexpr pointer lane(const SmallString &propName, const channel_counter_type chn = 0) noexcept {
+      return static_cast<base_t &>(*this).lane(_tagOffsets[propertyIndex(propName)] + chn);
+    }
+    template <bool InTile = WithinTile, enable_if_t<InTile> = 0>
+    constexpr const_pointer lane(const SmallString &propName,
+                                 const channel_counter_type chn = 0) const noexcept {
+      return static_cast<const base_t &>(*this).lane(_tagOffsets[propertyIndex(propName)] + chn);
+    }
+
     template <auto... Ns>
     constexpr auto pack(const SmallString &propName, const size_type i) const noexcept {
       return static_cast<const base_t &>(*this).template pack<Ns...>(
@@ -818,4 +933,177 @@ namespace zs {
     return TileVectorView<ExecSpace, TileVector<T, Length, Allocator>, false>{tagNames, vec};
   }
 
-}  // namespace zs
\ No newline at end of file
+  template <typename TileVectorView, typename F> struct TileVectorForEachTile {
+    using size_type = typename TileVectorView::size_type;
+    TileVectorForEachTile(TileVectorView tv, F f) : tv{tv}, f{f} {}
+    constexpr void operator()(size_type tileid) { f(tileid, tv.tile(tileid)); }
+    TileVectorView tv;
+    F f;
+  };
+  /// hands f(tileid, tile) every tile of a host tilevector view, the lanes of the last tile past
+  /// size() are allocated padding
+  template <typename Policy, typename TileVectorView, typename F>
+  void for_each_tile(Policy &&policy, TileVectorView tv, F &&f) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "for_each_tile is meant for host backends");
+    const auto numTiles = (tv.size() + TileVectorView::lane_width - 1) / TileVectorView::lane_width;
+    policy(range(numTiles), TileVectorForEachTile<TileVectorView, remove_cvref_t<F>>{tv, FWD(f)});
+  }
+
+  /// compile-time channel layout, properties are keyed by tag types exposing a static name, e.g.
+  ///   struct pos_t { static constexpr const char *name = "x"; };
+  ///   using schema_t = TileSchema<TileProperty<pos_t, 3>, TileProperty<vel_t, 3>>;
+  ///   auto pars = proxy<space, schema_t>(tilevector);
+  ///   auto x = pars.pack<3>(wrapt_v<pos_t>, i);
+  template <typename Tag, int N> struct TileProperty {
+    using tag_type = Tag;
+    static constexpr int num_channels = N;
+  };
+  template <typename... Props> struct TileSchema {
+    static constexpr int num_properties = sizeof...(Props);
+    static constexpr int num_channels = (Props::num_channels + ... + 0);
+
+    template <typename Tag> static constexpr int property_index() noexcept {
+      int i = 0, ret = -1;
+      ((is_same_v<Tag, typename Props::tag_type> ? (void)(ret = i++) : (void)i++), ...);
+      return ret;
+    }
+    template <typename Tag> static constexpr bool has_property() noexcept {
+      return property_index<Tag>() != -1;
+    }
+    template <typename Tag> static constexpr int property_size() noexcept {
+      int i = 0, ret = 0;
+      ((i++ == property_index<Tag>() ? (void)(ret = Props::num_channels) : (void)0), ...);
+      return ret;
+    }
+    template <typename Tag> static constexpr int property_offset() noexcept {
+      int i = 0, offset = 0, ret = 0;
+      ((i++ == property_index<Tag>() ? (void)(ret = offset) : (void)0,
+        offset += Props::num_channels),
+       ...);
+      return ret;
+    }
+    static std::vector<PropertyTag> get_property_tags() {
+      return {PropertyTag{Props::tag_type::name, Props::num_channels}...};
+    }
+    /// whether every property sits at the same channel offset in tv
+    template <typename TileVectorT> static bool matches(const TileVectorT &tv) {
+      if (tv.numChannels() != num_channels) return false;
+      return ((tv.getChannelSize(Props::tag_type::name) == Props::num_channels
+               && tv.getChannelOffset(Props::tag_type::name)
+                      == property_offset<typename Props::tag_type>())
+              && ...);
+    }
+  };
+
+  template <typename T> struct is_tile_schema : std::false_type {};
+  template <typename... Props> struct is_tile_schema<TileSchema<Props...>> : std::true_type {};
+
+  template <execspace_e Space, typename TileVectorT, typename Schema>
+  struct TileVectorSchemaView : TileVectorUnnamedView<Space, TileVectorT, false> {
+    using base_t = TileVectorUnnamedView<Space, TileVectorT, false>;
+    using schema_type = Schema;
+
+    static constexpr bool is_const_structure = base_t::is_const_structure;
+    using value_type = typename base_t::value_type;
+    using reference = typename base_t::reference;
+    using const_reference = typename base_t::const_reference;
+    using size_type = typename base_t::size_type;
+    using channel_counter_type = typename base_t::channel_counter_type;
+    static constexpr auto lane_width = base_t::lane_width;
+    static constexpr bool is_power_of_two = base_t::is_power_of_two;
+    static constexpr auto num_lane_bits = base_t::num_lane_bits;
+    static constexpr channel_counter_type num_channels = Schema::num_channels;
+
+    TileVectorSchemaView() noexcept = default;
+    explicit constexpr TileVectorSchemaView(TileVectorT &tilevector) : base_t{tilevector} {}
+
+    template <typename Tag> static constexpr channel_counter_type propertyOffset(wrapt<Tag>) {
+      static_assert(Schema::template has_property<Tag>(), "property not in the tile schema!");
+      return Schema::template property_offset<Tag>();
+    }
+    template <typename Tag> static constexpr channel_counter_type propertySize(wrapt<Tag>) {
+      static_assert(Schema::template has_property<Tag>(), "property not in the tile schema!");
+      return Schema::template property_size<Tag>();
+    }
+    /// the channel count is known at compile time, so is every stride
+    static constexpr size_type address(const channel_counter_type chn,
+                                       const size_type i) noexcept {
+      if constexpr (is_power_of_two)
+        return (((i >> num_lane_bits) * num_channels + chn) << num_lane_bits)
+               | (i & (lane_width - 1));
+      else
+        return (i / lane_width * num_channels + chn) * lane_width + i % lane_width;
+    }
+
+    using base_t::operator();
+    using base_t::pack;
+    using base_t::tuple;
+
+    template <typename Tag, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr reference operator()(wrapt<Tag> tag, const channel_counter_type chn,
+                                   const size_type i) noexcept {
+      return *(this->_vector + address(propertyOffset(tag) + chn, i));
+    }
+    template <typename Tag>
+    constexpr const_reference operator()(wrapt<Tag> tag, const channel_counter_type chn,
+                                         const size_type i) const noexcept {
+      return *(this->_vector + address(propertyOffset(tag) + chn, i));
+    }
+    template <typename Tag, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr reference operator()(wrapt<Tag> tag, const size_type i) noexcept {
+      return *(this->_vector + address(propertyOffset(tag), i));
+    }
+    template <typename Tag>
+    constexpr const_reference operator()(wrapt<Tag> tag, const size_type i) const noexcept {
+      return *(this->_vector + address(propertyOffset(tag), i));
+    }
+
+    template <auto... Ns, typename Tag>
+    constexpr auto pack(wrapt<Tag> tag, const size_type i) const noexcept {
+      using RetT = vec<value_type, Ns...>;
+      RetT ret{};
+      size_type offset = address(propertyOffset(tag), i);
+      for (channel_counter_type d = 0; d != RetT::extent; ++d, offset += lane_width)
+        ret.val(d) = *(this->_vector + offset);
+      return ret;
+    }
+    template <auto d, typename Tag, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr auto tuple(wrapt<Tag> tag, const size_type i) noexcept {
+      return tuple_impl(address(propertyOffset(tag), i), std::make_index_sequence<d>{});
+    }
+    template <auto d, typename Tag>
+    constexpr auto tuple(wrapt<Tag> tag, const size_type i) const noexcept {
+      return tuple_impl(address(propertyOffset(tag), i), std::make_index_sequence<d>{});
+    }
+
+  protected:
+    template <std::size_t... Is, bool V = is_const_structure, enable_if_t<!V> = 0>
+    constexpr auto tuple_impl(const size_type offset, index_seq<Is...>) noexcept {
+      return zs::tie(*(this->_vector + offset + Is * lane_width)...);
+    }
+    template <std::size_t... Is>
+    constexpr auto tuple_impl(const size_type offset, index_seq<Is...>) const noexcept {
+      return zs::tie(*(this->_vector + offset + Is * lane_width)...);
+    }
+  };
+
+  /// the schema is an explicit template argument, a schema object parameter would make
+  /// proxy<space>({}, tilevector) ambiguous with the property-name overloads
+  template <execspace_e ExecSpace, typename Schema, typename T, std::size_t Length,
+            typename Allocator, enable_if_t<is_tile_schema<Schema>::value> = 0>
+  decltype(auto) proxy(const TileVector<T, Length, Allocator> &vec) {
+    if (!Schema::matches(vec))
+      throw std::runtime_error("tilevector channel layout does not match the tile schema");
+    return TileVectorSchemaView<ExecSpace, const TileVector<T, Length, Allocator>, Schema>{vec};
+  }
+  template <execspace_e ExecSpace, typename Schema, typename T, std::size_t Length,
+            typename Allocator, enable_if_t<is_tile_schema<Schema>::value> = 0>
+  decltype(auto) proxy(TileVector<T, Length, Allocator> &vec) {
+    if (!Schema::matches(vec))
+      throw std::runtime_error("tilevector channel layout does not match the tile schema");
+    return TileVectorSchemaView<ExecSpace, TileVector<T, Length, Allocator>, Schema>{vec};
+  }
+
+}  // namespace zs
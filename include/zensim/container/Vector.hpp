@@ -1,12 +1,15 @@
 #pragma once
 #include <type_traits>
 
+#include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/memory/Allocator.h"
 #include "zensim/resource/Resource.h"
 #include "zensim/types/Iterator.h"
 
 namespace zs {
 
+  struct ErasureMarks;
+
   template <typename T, typename AllocatorT = ZSPmrAllocator<>> struct Vector {
     static_assert(is_zs_allocator<AllocatorT>::value,
                   "Vector only works with zspmrallocator for now.");
@@ -42,7 +45,9 @@ namespace zs {
     pointer allocate(std::size_t bytes) {
       /// virtual memory way
       if constexpr (is_virtual_zs_allocator<allocator_type>::value) {
-        _allocator.commit(0, bytes);
+        if (!_allocator.commit(0, bytes))
+          throw std::runtime_error(
+              fmt::format("unable to commit {} bytes of the virtual address range", bytes));
         return (pointer)_allocator.address(0);
       }
       /// conventional way
@@ -204,6 +209,11 @@ namespace zs {
     void reset(int ch) {
       Resource::memset(MemoryEntity{memoryLocation(), (void *)data()}, ch, usedBytes());
     }
+    /// see Resource::memset
+    template <typename Policy> void reset(Policy &&policy, int ch) {
+      Resource::memset(FWD(policy), MemoryEntity{memoryLocation(), (void *)data()}, ch,
+                       usedBytes());
+    }
     void resize(size_type newSize) {
       const auto oldSize = size();
       if (newSize < oldSize) {
@@ -213,10 +223,10 @@ namespace zs {
       if (newSize > oldSize) {
         const auto oldCapacity = capacity();
         if (newSize > oldCapacity) {
-          /// virtual memory way
+          /// virtual memory way, grows in place
           if constexpr (is_virtual_zs_allocator<allocator_type>::value) {
+            allocate(geometric_size_growth(newSize) * sizeof(value_type));
             _capacity = geometric_size_growth(newSize);
-            _allocator.commit(_capacity * sizeof(value_type));
             _size = newSize;
           }
           /// conventional way
@@ -233,6 +243,13 @@ namespace zs {
           _size = newSize;
       }
     }
+    /// grows the capacity without touching the size
+    void reserve(size_type newCapacity) {
+      if (newCapacity <= capacity()) return;
+      const auto oldSize = size();
+      resize(newCapacity);
+      _size = oldSize;
+    }
     void resize(size_type newSize, int ch) {
       const auto oldSize = size();
       if (newSize < oldSize) {
@@ -244,10 +261,10 @@ namespace zs {
       if (newSize > oldSize) {
         const auto oldCapacity = capacity();
         if (newSize > oldCapacity) {
-          /// virtual memory way
+          /// virtual memory way, grows in place
           if constexpr (is_virtual_zs_allocator<allocator_type>::value) {
+            allocate(geometric_size_growth(newSize) * sizeof(value_type));
             _capacity = geometric_size_growth(newSize);
-            _allocator.commit(_capacity * sizeof(value_type));
             Resource::memset(MemoryEntity{memoryLocation(), (void *)(data() + _size)}, ch,
                              sizeof(T) * (newSize - _size));
             _size = newSize;
@@ -273,11 +290,11 @@ namespace zs {
     }
 
     void push_back(const value_type &val) {
-      if (size() >= capacity()) resize(size() + 1);
+      if (size() >= capacity()) reserve(size() + 1);
       (*this)[_size++] = val;
     }
     void push_back(value_type &&val) {
-      if (size() >= capacity()) resize(size() + 1);
+      if (size() >= capacity()) reserve(size() + 1);
       (*this)[_size++] = std::move(val);
     }
 
@@ -292,6 +309,11 @@ namespace zs {
       Resource::copy(MemoryEntity{memoryLocation(), (void *)(_base + size())},
                      MemoryEntity{other.memoryLocation(), (void *)other.data()}, sizeof(T) * count);
     }
+    /// stable removal of the elements satisfying pred(const value_type &), returns the count
+    template <typename Policy, typename Predicate>
+    size_type erase_if(Policy &&policy, Predicate &&pred);
+    /// keeps (in order) the elements left unerased by mark_erasure
+    template <typename Policy> void compact(Policy &&policy, const ErasureMarks &kept);
 
   protected:
     constexpr std::size_t usedBytes() const noexcept { return sizeof(T) * size(); }
@@ -387,4 +409,79 @@ namespace zs {
     return VectorView<ExecSpace, const Vector<T, Allocator>>{vec};
   }
 
+  /// the erase_if bookkeeping shared by the containers. marks[i] is 1 for every index that
+  /// stays and offsets[i] is then its destination (offsets holds n + 1 entries since the
+  /// sequential exclusive_scan also writes the total)
+  struct ErasureMarks {
+    Vector<std::size_t> marks, offsets;
+    std::size_t numKept;
+  };
+  template <typename MarkView, typename Predicate> struct MarkUnerased {
+    using size_type = typename MarkView::size_type;
+    MarkUnerased(MarkView marks, Predicate pred) : marks{marks}, pred{pred} {}
+    constexpr void operator()(size_type i) { marks[i] = pred(i) ? 0 : 1; }
+    MarkView marks;
+    Predicate pred;
+  };
+  /// evaluates the index predicate erasePred(i) exactly once for every i in [0, n), so that
+  /// several containers can be compacted consistently by the same marks
+  template <typename Policy, typename Predicate>
+  ErasureMarks mark_erasure(Policy &&policy, const MemoryLocation &mloc, std::size_t n,
+                            Predicate &&erasePred) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    auto allocator = get_memory_source(mloc.memspace(), mloc.devid());
+    ErasureMarks ret{Vector<std::size_t>{allocator, n}, Vector<std::size_t>{allocator, n + 1},
+                     (std::size_t)0};
+    if (n == 0) return ret;
+    policy(range(n),
+           MarkUnerased{proxy<space>(ret.marks), remove_cvref_t<Predicate>{erasePred}});
+    exclusive_scan(policy, ret.marks.begin(), ret.marks.end(), ret.offsets.begin());
+    ret.numKept = ret.offsets.getVal(n - 1) + ret.marks.getVal(n - 1);
+    return ret;
+  }
+
+  /// turns a predicate on the elements into one on their indices
+  template <typename VectorView, typename Predicate> struct VectorElementPredicate {
+    using size_type = typename VectorView::size_type;
+    VectorElementPredicate(VectorView vec, Predicate pred) : vec{vec}, pred{pred} {}
+    constexpr bool operator()(size_type i) { return pred(vec[i]); }
+    VectorView vec;
+    Predicate pred;
+  };
+  /// scatters the marked entries of src to their scanned offsets in dst
+  template <typename SrcView, typename DstView, typename MarkView, typename OffsetView>
+  struct VectorCompact {
+    using size_type = typename SrcView::size_type;
+    VectorCompact(SrcView src, DstView dst, MarkView marks, OffsetView offsets)
+        : src{src}, dst{dst}, marks{marks}, offsets{offsets} {}
+    constexpr void operator()(size_type i) {
+      if (marks[i]) dst[offsets[i]] = src[i];
+    }
+    SrcView src;
+    DstView dst;
+    MarkView marks;
+    OffsetView offsets;
+  };
+  template <typename T, typename Allocator> template <typename Policy>
+  void Vector<T, Allocator>::compact(Policy &&policy, const ErasureMarks &kept) {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    if (kept.numKept == size()) return;
+    Vector tmp{_allocator, kept.numKept};
+    policy(range(size()),
+           VectorCompact{proxy<space>(std::as_const(*this)), proxy<space>(tmp),
+                         proxy<space>(kept.marks), proxy<space>(kept.offsets)});
+    *this = std::move(tmp);
+  }
+  template <typename T, typename Allocator> template <typename Policy, typename Predicate>
+  auto Vector<T, Allocator>::erase_if(Policy &&policy, Predicate &&pred) -> size_type {
+    constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+    const auto n = size();
+    const auto kept
+        = mark_erasure(policy, memoryLocation(), n,
+                       VectorElementPredicate{proxy<space>(std::as_const(*this)),
+                                              remove_cvref_t<Predicate>{pred}});
+    compact(policy, kept);
+    return n - kept.numKept;
+  }
+
 }  // namespace zs
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include "Vector.hpp"
+#include "zensim/execution/Atomics.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+namespace zs {
+
+  /// concurrent append onto the tail of a Vector from within parallel kernels
+  /// pushes beyond the reserved capacity are counted but dropped, thus the host side protocol is
+  ///   VectorAppender appender{vec, estimatedCount};
+  ///   do {
+  ///     policy(range(n), Kernel{proxy<space>(appender)});
+  ///   } while (appender.grow_and_retry());
+  /// after which vec holds the previous entries followed by all the appended ones
+  template <typename T, typename AllocatorT = ZSPmrAllocator<>> struct VectorAppender {
+    using vector_type = Vector<T, AllocatorT>;
+    using value_type = typename vector_type::value_type;
+    using allocator_type = typename vector_type::allocator_type;
+    using size_type = typename vector_type::size_type;
+    using index_t = unsigned long long;
+    using counter_t = Vector<index_t>;
+
+    VectorAppender(vector_type &vec, size_type estimatedCount = 0)
+        : _vector{vec},
+          _base{vec.size()},
+          _cnt{get_memory_source(vec.memspace(), vec.devid()), 1} {
+      _vector.reserve(_base + estimatedCount);
+      _cnt.setVal((index_t)_base);
+    }
+
+    /// number of entries pushed so far (including the previous ones and the dropped ones)
+    size_type count() const { return (size_type)_cnt.getVal(); }
+    constexpr size_type capacity() const noexcept { return _vector.capacity(); }
+    size_type overflow_count() const {
+      const auto cnt = count();
+      return cnt > capacity() ? cnt - capacity() : 0;
+    }
+
+    /// returns 0 and settles the vector's size once every push fit, otherwise discards this
+    /// round of appends, grows the vector to fit them and returns the number of dropped entries
+    size_type grow_and_retry() {
+      const auto cnt = count();
+      if (cnt <= capacity()) {
+        _vector.resize(cnt);
+        return 0;
+      }
+      const auto numOverflowed = cnt - capacity();
+      _vector.reserve(cnt);
+      _cnt.setVal((index_t)_base);
+      return numOverflowed;
+    }
+
+    vector_type &_vector;
+    size_type _base;
+    counter_t _cnt;
+  };
+
+  template <typename T, typename AllocatorT> VectorAppender(Vector<T, AllocatorT> &)
+      -> VectorAppender<T, AllocatorT>;
+  template <typename T, typename AllocatorT, typename SizeT>
+  VectorAppender(Vector<T, AllocatorT> &, SizeT) -> VectorAppender<T, AllocatorT>;
+
+  template <execspace_e space, typename VectorAppenderT, typename = void>
+  struct VectorAppenderView {
+    using value_type = typename VectorAppenderT::value_type;
+    using size_type = typename VectorAppenderT::size_type;
+    using index_t = typename VectorAppenderT::index_t;
+    using pointer = typename VectorAppenderT::vector_type::pointer;
+
+    static constexpr index_t sentinel_v = ~(index_t)0;
+
+    VectorAppenderView() noexcept = default;
+    explicit constexpr VectorAppenderView(VectorAppenderT &appender)
+        : _vector{appender._vector.data()},
+          _cnt{appender._cnt.data()},
+          _capacity{(index_t)appender.capacity()} {}
+
+    /// returns the slot written to, or sentinel_v if the push overflowed
+#if defined(__CUDACC__)
+    template <execspace_e S = space, enable_if_t<S == execspace_e::cuda> = 0>
+    __forceinline__ __device__ index_t atomic_push_back(const value_type &val) {
+      const auto no = atomic_add(wrapv<space>{}, _cnt, (index_t)1);
+      if (no < _capacity) {
+        _vector[no] = val;
+        return no;
+      }
+      return sentinel_v;
+    }
+    /// claims count consecutive slots at once, all or nothing
+    template <execspace_e S = space, enable_if_t<S == execspace_e::cuda> = 0>
+    __forceinline__ __device__ index_t atomic_reserve(index_t count) {
+      const auto no = atomic_add(wrapv<space>{}, _cnt, count);
+      return no + count <= _capacity ? no : sentinel_v;
+    }
+#endif
+    template <execspace_e S = space, enable_if_t<S != execspace_e::cuda> = 0>
+    inline index_t atomic_push_back(const value_type &val) {
+      const auto no = atomic_add(wrapv<space>{}, _cnt, (index_t)1);
+      if (no < _capacity) {
+        _vector[no] = val;
+        return no;
+      }
+      return sentinel_v;
+    }
+    /// claims count consecutive slots at once, all or nothing
+    template <execspace_e S = space, enable_if_t<S != execspace_e::cuda> = 0>
+    inline index_t atomic_reserve(index_t count) {
+      const auto no = atomic_add(wrapv<space>{}, _cnt, count);
+      return no + count <= _capacity ? no : sentinel_v;
+    }
+    /// for filling the slots claimed by atomic_reserve
+    constexpr value_type &operator[](index_t no) { return _vector[no]; }
+    constexpr index_t capacity() const noexcept { return _capacity; }
+
+    pointer _vector{nullptr};
+    index_t *_cnt{nullptr};
+    index_t _capacity{0};
+  };
+
+  template <execspace_e ExecSpace, typename T, typename Allocator>
+  constexpr decltype(auto) proxy(VectorAppender<T, Allocator> &appender) {
+    return VectorAppenderView<ExecSpace, VectorAppender<T, Allocator>>{appender};
+  }
+
+}  // namespace zs
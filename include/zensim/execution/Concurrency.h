@@ -111,6 +111,10 @@ namespace zs {
       std::unique_lock<std::shared_mutex> lk(_rw);
       _map.erase(key);
     }
+    void clear() {
+      std::unique_lock<std::shared_mutex> lk(_rw);
+      _map.clear();
+    }
     template <typename... Args> decltype(auto) emplace(Args &&...args) {
       std::unique_lock<std::shared_mutex> lk(_rw);
       return _map.emplace(std::forward<Args>(args)...);
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 #include "zensim/TypeAlias.hpp"
 #include "zensim/memory/MemoryResource.h"
+#include "zensim/memory/ScratchArena.hpp"
 #include "zensim/profile/CppTimers.hpp"
 #include "zensim/zpc_tpls/fmt/format.h"
 #include "zensim/zpc_tpls/magic_enum/magic_enum.hpp"
@@ -168,8 +172,9 @@ namespace zs {
       int binCount = 1 << binBits;
       int binMask = binCount - 1;
 
-      std::vector<DiffT> binGlobalSizes(binCount);
-      std::vector<DiffT> binOffsets(binCount);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      DiffT *binGlobalSizes = scratch.acquire<DiffT>(binCount);
+      DiffT *binOffsets = scratch.acquire<DiffT>(binCount);
 
       std::vector<InputValueT> buffers[2];
       buffers[0].resize(dist);
@@ -236,8 +241,9 @@ namespace zs {
       int binCount = 1 << binBits;
       int binMask = binCount - 1;
 
-      std::vector<DiffT> binGlobalSizes(binCount);
-      std::vector<DiffT> binOffsets(binCount);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      DiffT *binGlobalSizes = scratch.acquire<DiffT>(binCount);
+      DiffT *binOffsets = scratch.acquire<DiffT>(binCount);
 
       std::vector<KeyT> keyBuffers[2];
       std::vector<ValueT> valBuffers[2];
@@ -298,6 +304,137 @@ namespace zs {
         *(valsOut + i) = curVals[i];
       }
     }
+    template <class RandomIt,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+    void sort(RandomIt &&first, RandomIt &&last, Compare &&comp = {}) const {
+      std::sort(first, last, comp);
+    }
+    template <class RandomIt,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+    void stable_sort(RandomIt &&first, RandomIt &&last, Compare &&comp = {}) const {
+      std::stable_sort(first, last, comp);
+    }
+    template <class KeyIter, class ValueIter,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    void sort_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                     Compare &&comp = {}) const {
+      using KeyT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type;
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type;
+      using DiffT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::difference_type;
+      const DiffT dist = keysLast - keysFirst;
+      std::vector<std::pair<KeyT, ValueT>> pairs(dist);
+      for (DiffT i = 0; i < dist; ++i) {
+        pairs[i].first = *(keysFirst + i);
+        pairs[i].second = *(valsFirst + i);
+      }
+      std::stable_sort(pairs.begin(), pairs.end(),
+                       [&comp](const auto &a, const auto &b) { return comp(a.first, b.first); });
+      for (DiffT i = 0; i < dist; ++i) {
+        *(keysFirst + i) = pairs[i].first;
+        *(valsFirst + i) = pairs[i].second;
+      }
+    }
+    /// stream compaction, stable, returns the number of selected elements
+    template <class InputIt, class OutputIt, class Predicate>
+    auto copy_if(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred) const {
+      typename std::iterator_traits<remove_cvref_t<InputIt>>::difference_type n = 0;
+      for (auto it = first; it != last; ++it)
+        if (pred(*it)) *(d_first + n++) = *it;
+      return n;
+    }
+    template <class ForwardIt, class Predicate>
+    auto remove_if(ForwardIt &&first, ForwardIt &&last, Predicate &&pred) const {
+      return std::distance(first, std::remove_if(first, last, pred));
+    }
+    template <class ForwardIt, class Predicate>
+    auto partition(ForwardIt &&first, ForwardIt &&last, Predicate &&pred) const {
+      return std::distance(first, std::stable_partition(first, last, pred));
+    }
+    /// segment-wise primitives over runs of equal keys, returning the number of runs. like the
+    /// omp versions a run continues as long as pred holds for adjacent elements (rather than for
+    /// the first one of the run as in std::unique)
+    template <class ForwardIt,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type>>
+    auto unique(ForwardIt &&first, ForwardIt &&last, BinaryPredicate &&pred = {}) const {
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type;
+      const auto dist = last - first;
+      RM_CVREF_T(dist) n = 0;
+      ValueT prev{};  ///< the predecessor before being overwritten
+      for (RM_CVREF_T(dist) i = 0; i < dist; ++i) {
+        const bool head = i == 0 || !pred(prev, *(first + i));
+        prev = *(first + i);
+        if (head) {
+          if (n != i) *(first + n) = std::move(*(first + i));
+          ++n;
+        }
+      }
+      return n;
+    }
+    template <class KeyIter, class ValueIter,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    auto unique_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                       BinaryPredicate &&pred = {}) const {
+      using KeyT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type;
+      const auto dist = keysLast - keysFirst;
+      RM_CVREF_T(dist) n = 0;
+      KeyT prev{};
+      for (RM_CVREF_T(dist) i = 0; i < dist; ++i) {
+        const bool head = i == 0 || !pred(prev, *(keysFirst + i));
+        prev = *(keysFirst + i);
+        if (head) {
+          if (n != i) {
+            *(keysFirst + n) = std::move(*(keysFirst + i));
+            *(valsFirst + n) = std::move(*(valsFirst + i));
+          }
+          ++n;
+        }
+      }
+      return n;
+    }
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>,
+              class BinaryOp
+              = std::plus<typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type>>
+    auto reduce_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                       KeyOutIter &&keysOut, ValueOutIter &&valsOut, BinaryPredicate &&pred = {},
+                       BinaryOp &&op = {}) const {
+      const auto dist = keysLast - keysFirst;
+      RM_CVREF_T(dist) n = 0;
+      for (RM_CVREF_T(dist) i = 0; i < dist;) {
+        auto acc = *(valsFirst + i);
+        auto j = i + 1;
+        for (; j < dist && pred(*(keysFirst + (j - 1)), *(keysFirst + j)); ++j)
+          acc = op(acc, *(valsFirst + j));
+        *(keysOut + n) = *(keysFirst + i);
+        *(valsOut + n++) = acc;
+        i = j;
+      }
+      return n;
+    }
+    template <class InputIt, class OutputIt, class CountIt,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<InputIt>>::value_type>>
+    auto run_length_encode(InputIt &&first, InputIt &&last, OutputIt &&uniqueOut,
+                           CountIt &&countsOut, BinaryPredicate &&pred = {}) const {
+      using CountT = typename std::iterator_traits<remove_cvref_t<CountIt>>::value_type;
+      const auto dist = last - first;
+      RM_CVREF_T(dist) n = 0;
+      for (RM_CVREF_T(dist) i = 0; i < dist;) {
+        auto j = i + 1;
+        for (; j < dist && pred(*(first + (j - 1)), *(first + j)); ++j)
+          ;
+        *(uniqueOut + n) = *(first + i);
+        *(countsOut + n++) = (CountT)(j - i);
+        i = j;
+      }
+      return n;
+    }
 
   protected:
     bool do_launch(const ParallelTask &) const noexcept;
@@ -413,6 +550,89 @@ namespace zs {
       int ebit = sizeof(typename std::iterator_traits<remove_cvref_t<InputIt>>::value_type) * 8) {
     policy.radix_sort(FWD(first), FWD(last), FWD(d_first), sbit, ebit);
   }
+  /// comparison sorts, in place
+  template <class ExecutionPolicy, class RandomIt,
+            class Compare
+            = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+  constexpr void sort(ExecutionPolicy &&policy, RandomIt &&first, RandomIt &&last,
+                      Compare &&comp = {}) {
+    policy.sort(FWD(first), FWD(last), FWD(comp));
+  }
+  template <class ExecutionPolicy, class RandomIt,
+            class Compare
+            = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+  constexpr void stable_sort(ExecutionPolicy &&policy, RandomIt &&first, RandomIt &&last,
+                             Compare &&comp = {}) {
+    policy.stable_sort(FWD(first), FWD(last), FWD(comp));
+  }
+  /// stable, values are permuted along with their keys
+  template <class ExecutionPolicy, class KeyIter, class ValueIter,
+            class Compare
+            = std::less<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+  constexpr void sort_by_key(ExecutionPolicy &&policy, KeyIter &&keysFirst, KeyIter &&keysLast,
+                             ValueIter &&valsFirst, Compare &&comp = {}) {
+    policy.sort_by_key(FWD(keysFirst), FWD(keysLast), FWD(valsFirst), FWD(comp));
+  }
+  /// stream compaction (stable), returning the number of selected elements
+  /// copy_if writes the elements satisfying pred to d_first
+  template <class ExecutionPolicy, class InputIt, class OutputIt, class Predicate>
+  constexpr auto copy_if(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last,
+                         OutputIt &&d_first, Predicate &&pred) {
+    return policy.copy_if(FWD(first), FWD(last), FWD(d_first), FWD(pred));
+  }
+  /// remove_if keeps the elements not satisfying pred at the front
+  template <class ExecutionPolicy, class ForwardIt, class Predicate>
+  constexpr auto remove_if(ExecutionPolicy &&policy, ForwardIt &&first, ForwardIt &&last,
+                           Predicate &&pred) {
+    return policy.remove_if(FWD(first), FWD(last), FWD(pred));
+  }
+  /// partition moves the elements satisfying pred before the others
+  template <class ExecutionPolicy, class ForwardIt, class Predicate>
+  constexpr auto partition(ExecutionPolicy &&policy, ForwardIt &&first, ForwardIt &&last,
+                           Predicate &&pred) {
+    return policy.partition(FWD(first), FWD(last), FWD(pred));
+  }
+  /// segment-wise primitives over consecutive runs of equal keys (usually after a sort),
+  /// returning the number of runs
+  /// unique keeps the first element of every run at the front
+  template <class ExecutionPolicy, class ForwardIt,
+            class BinaryPredicate
+            = std::equal_to<typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type>>
+  constexpr auto unique(ExecutionPolicy &&policy, ForwardIt &&first, ForwardIt &&last,
+                        BinaryPredicate &&pred = {}) {
+    return policy.unique(FWD(first), FWD(last), FWD(pred));
+  }
+  /// unique_by_key keeps the first key of every run along with its value at the front
+  template <class ExecutionPolicy, class KeyIter, class ValueIter,
+            class BinaryPredicate
+            = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+  constexpr auto unique_by_key(ExecutionPolicy &&policy, KeyIter &&keysFirst, KeyIter &&keysLast,
+                               ValueIter &&valsFirst, BinaryPredicate &&pred = {}) {
+    return policy.unique_by_key(FWD(keysFirst), FWD(keysLast), FWD(valsFirst), FWD(pred));
+  }
+  /// reduce_by_key writes the key and the folded values of every run
+  template <class ExecutionPolicy, class KeyIter, class ValueIter, class KeyOutIter,
+            class ValueOutIter,
+            class BinaryPredicate
+            = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>,
+            class BinaryOp
+            = std::plus<typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type>>
+  constexpr auto reduce_by_key(ExecutionPolicy &&policy, KeyIter &&keysFirst, KeyIter &&keysLast,
+                               ValueIter &&valsFirst, KeyOutIter &&keysOut, ValueOutIter &&valsOut,
+                               BinaryPredicate &&pred = {}, BinaryOp &&op = {}) {
+    return policy.reduce_by_key(FWD(keysFirst), FWD(keysLast), FWD(valsFirst), FWD(keysOut),
+                                FWD(valsOut), FWD(pred), FWD(op));
+  }
+  /// run_length_encode writes the value and the length of every run
+  template <class ExecutionPolicy, class InputIt, class OutputIt, class CountIt,
+            class BinaryPredicate
+            = std::equal_to<typename std::iterator_traits<remove_cvref_t<InputIt>>::value_type>>
+  constexpr auto run_length_encode(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last,
+                                   OutputIt &&uniqueOut, CountIt &&countsOut,
+                                   BinaryPredicate &&pred = {}) {
+    return policy.run_length_encode(FWD(first), FWD(last), FWD(uniqueOut), FWD(countsOut),
+                                    FWD(pred));
+  }
   /// gather/ select (flagged, if, unique)
 
 }  // namespace zs
\ No newline at end of file
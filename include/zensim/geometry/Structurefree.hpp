@@ -19,6 +19,16 @@ namespace zs {
   };
   using ParticleAttributeFlagBits = char;
 
+  template <typename SrcView, typename DstView, typename OrderView>
+  struct ParticlesAttributePermute {
+    ParticlesAttributePermute(SrcView src, DstView dst, OrderView order)
+        : src{src}, dst{dst}, order{order} {}
+    constexpr void operator()(typename DstView::size_type i) { dst[i] = src[order[i]]; }
+    SrcView src;
+    DstView dst;
+    OrderView order;
+  };
+
   template <typename ValueT = f32, int d = 3> struct Particles {
     using T = ValueT;
     // using TV = ValueT[d];
@@ -210,6 +220,39 @@ namespace zs {
           _attributes[attrib.first] = attrib.second;
     }
 
+    /// reorders every attribute such that particle i becomes the previous particle order[i]
+    template <typename Policy, typename IndexT, typename IndexAllocator>
+    void permute(Policy &&policy, const Vector<IndexT, IndexAllocator> &order) {
+      constexpr execspace_e space = RM_CVREF_T(policy)::exec_tag::value;
+      if (order.size() != size())
+        throw std::runtime_error(
+            fmt::format("permute: the order has [{}] entries whereas there are [{}] particles.",
+                        order.size(), size()));
+      for (auto &&attrib : _attributes)
+        match([&policy, &order](auto &&att) {
+          RM_CVREF_T(att) tmp{att.get_allocator(), att.size()};
+          policy(range(att.size()), ParticlesAttributePermute{proxy<space>(std::as_const(att)),
+                                                              proxy<space>(tmp),
+                                                              proxy<space>(order)});
+          att = std::move(tmp);
+        })(attrib.second);
+      if (particleBins.size() == order.size()) particleBins.permute(policy, order);
+    }
+
+    /// stable removal of the particles whose index satisfies pred(i), returns the count
+    template <typename Policy, typename Predicate>
+    size_type erase_if(Policy &&policy, Predicate &&pred) {
+      const size_type n = size();
+      /// pred (which may read the attributes) is evaluated once, before anything is compacted,
+      /// thus the bins and the attributes are compacted by the very same marks
+      const auto kept = mark_erasure(policy, get_allocator().location, n, FWD(pred));
+      if (kept.numKept == n) return 0;
+      if (particleBins.size() == n) particleBins.compact(policy, kept);
+      for (auto &&attrib : _attributes)
+        match([&](auto &&att) { att.compact(policy, kept); })(attrib.second);
+      return n - kept.numKept;
+    }
+
     void resize(std::size_t newSize) {
       for (auto &&attrib : attrs()) match([newSize](auto &&att) { att.resize(newSize); })(attrib);
     }
@@ -71,7 +71,7 @@ namespace zs {
     constexpr bool onwin = false;
 #endif
     if constexpr (is_backend_available(exec_omp) && !onwin) {
-      auto ompExec = omp_exec();
+      auto ompExec = omp_exec().stealing(32);
       ret._table.reset(ompExec, true);
       // tbb::parallel_for(LeafCIterRange{gridPtr->tree().cbeginLeaf()}, lam);
       ompExec(LeafCIterRange{gridPtr->tree().cbeginLeaf()},
@@ -353,7 +353,7 @@ namespace zs {
     constexpr bool onwin = false;
 #endif
     if constexpr (is_backend_available(exec_omp) && !onwin) {
-      auto ompExec = omp_exec();
+      auto ompExec = omp_exec().stealing(32);
       ret._table.reset(ompExec, true);
       ompExec(LeafCIterRange{gridPtr->tree().cbeginLeaf()},
               [&ret, table = proxy<execspace_e::openmp>(ret._table),
@@ -517,7 +517,7 @@ namespace zs {
     constexpr bool onwin = false;
 #endif
     if constexpr (is_backend_available(exec_omp) && !onwin) {
-      auto ompExec = omp_exec();
+      auto ompExec = omp_exec().stealing(32);
       ret._table.reset(ompExec, true);
       ompExec(LeafCIterRange{gridPtr->tree().cbeginLeaf()},
               [&ret, table = proxy<execspace_e::openmp>(ret._table),
@@ -644,7 +644,7 @@ namespace zs {
     constexpr bool onwin = false;
 #endif
     if constexpr (is_backend_available(exec_omp) && !onwin) {
-      auto ompExec = omp_exec();
+      auto ompExec = omp_exec().stealing(32);
       auto lsv = proxy<execspace_e::openmp>(spls);
       using LsT = RM_CVREF_T(lsv);
       // for (const auto &blockid : spls._table._activeKeys)
@@ -1,12 +1,19 @@
 #include "Allocator.h"
+#include "ScratchArena.hpp"
 
 #include "zensim/Logger.hpp"
 #include "zensim/zpc_tpls/fmt/color.h"
 #include "zensim/zpc_tpls/fmt/core.h"
 #include "zensim/zpc_tpls/fmt/format.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
 #if defined(ZS_PLATFORM_UNIX)
 #  include <sys/mman.h>
+#  include <sys/syscall.h>
 #  include <unistd.h>
 #elif defined(ZS_PLATFORM_WINDOWS)
 #  define NOMINMAX
@@ -18,84 +25,217 @@ namespace zs {
 
 #if defined(ZS_PLATFORM_UNIX)
 
-#  if 0
-  stack_virtual_memory_resource<host_mem_tag>::stack_virtual_memory_resource(ProcID did,
-                                                                             std::string_view type)
-      : _type{type},
-        _granularity{0},
-        _addr{nullptr},
-        _offset{0},
-        _allocatedSpace{0},
-        _reservedSpace{0},
-        _did{did} {
-    if (did >= 0)
-      throw std::runtime_error(
-          fmt::format("hostvm target device index [{}] is not negative", (int)did));
-    if (type != "HOST_VIRTUAL")
-      throw std::runtime_error(
-          fmt::format("currently hostvm does not support allocation type {}", type));
+  /// numa_memory_resource
+#  if defined(ZS_PLATFORM_LINUX)
+  namespace {
+    /// numaif.h is part of libnuma, which is not a dependency
+    enum : int { zs_mpol_bind = 2, zs_mpol_interleave = 3 };
+    constexpr int zs_mpol_f_node = 1 << 0, zs_mpol_f_addr = 1 << 1;
+    constexpr std::size_t numa_mask_bits = 1024;
+    using numa_mask_t = std::array<unsigned long, numa_mask_bits / (8 * sizeof(unsigned long))>;
+
+    /// parses a cpulist-formatted line, e.g. "0-1,4"
+    numa_mask_t online_numa_nodes() {
+      numa_mask_t mask{};
+      std::FILE *fp = std::fopen("/sys/devices/system/node/online", "r");
+      if (fp == nullptr) {
+        mask[0] = 1;
+        return mask;
+      }
+      unsigned st{}, ed{};
+      while (std::fscanf(fp, "%u", &st) == 1) {
+        ed = st;
+        int c = std::fgetc(fp);
+        if (c == '-') {
+          if (std::fscanf(fp, "%u", &ed) != 1) break;
+          c = std::fgetc(fp);
+        }
+        for (auto i = st; i <= ed && i < numa_mask_bits; ++i)
+          mask[i / (8 * sizeof(unsigned long))] |= 1ul << (i % (8 * sizeof(unsigned long)));
+        if (c != ',') break;
+      }
+      std::fclose(fp);
+      if (std::all_of(mask.begin(), mask.end(), [](unsigned long m) { return m == 0; })) mask[0] = 1;
+      return mask;
+    }
+  }  // namespace
+#  endif
 
-    _granularity = (size_t)getpagesize();
+  numa_memory_resource<host_mem_tag>::numa_memory_resource(ProcID node, numa_placement_e placement)
+      : _node{node}, _placement{placement}, _granularity{(std::size_t)getpagesize()} {
+    if (placement == numa_placement_e::bind && (node < 0 || node >= num_nodes()))
+      throw std::runtime_error(
+          fmt::format("numa node [{}] to bind to is not online ({} nodes)", (int)node, num_nodes()));
   }
 
-  stack_virtual_memory_resource<host_mem_tag>::~stack_virtual_memory_resource() {
-    if (_reservedSpace) munmap(_addr, _reservedSpace);
+  void *numa_memory_resource<host_mem_tag>::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes == 0) return nullptr;
+    if (alignment > _granularity)
+      throw std::runtime_error(fmt::format("numa resource cannot align to {} bytes", alignment));
+    const std::size_t mappedBytes = round_up(bytes, _granularity);
+    /// no page is touched here, otherwise the allocating thread decides the placement
+    void *ret
+        = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ret == MAP_FAILED) throw std::bad_alloc{};
+#  if defined(ZS_PLATFORM_LINUX)
+    if (_placement != numa_placement_e::first_touch) {
+      numa_mask_t mask{};
+      int mode = zs_mpol_interleave;
+      if (_placement == numa_placement_e::bind) {
+        mode = zs_mpol_bind;
+        mask[_node / (8 * sizeof(unsigned long))] = 1ul << (_node % (8 * sizeof(unsigned long)));
+      } else
+        mask = online_numa_nodes();
+      if (syscall(SYS_mbind, ret, mappedBytes, mode, mask.data(), numa_mask_bits + 1, 0) != 0)
+        fmt::print(fmt::fg(fmt::color::yellow),
+                   "mbind failed ({}), numa placement falls back to first touch\n",
+                   std::strerror(errno));
+    }
+#  endif
+    if (allocation_telemetry_enabled())
+      record_allocation(mem_host, ret, "numa_memory_resource", bytes, alignment);
+    return ret;
   }
 
-  bool stack_virtual_memory_resource<host_mem_tag>::reserve(std::size_t desiredSpace) {
-    if (desiredSpace <= _reservedSpace) return true;
+  void numa_memory_resource<host_mem_tag>::do_deallocate(void *ptr, std::size_t bytes,
+                                                         std::size_t /*alignment*/) {
+    if (ptr == nullptr || bytes == 0) return;
+    if (allocation_telemetry_enabled())
+      erase_allocation(mem_host, ptr, "numa_memory_resource", bytes);
+    munmap(ptr, round_up(bytes, _granularity));
+  }
 
-    auto newSpace = (desiredSpace + _granularity - 1) / _granularity * _granularity;
-    if (_reservedSpace == 0) {
-      auto ret = mmap(nullptr, newSpace, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
-      if (ret == MAP_FAILED) return false;
-      _addr = ret;
-      _reservedSpace = newSpace;
-      return true;
-    }
-    auto ret = mremap(_addr, _reservedSpace, newSpace, MREMAP_MAYMOVE);
-    if (ret == MAP_FAILED) return false;
-    if (_addr != ret) _addr = ret;
-    _reservedSpace = newSpace;
-    return true;
+  int numa_memory_resource<host_mem_tag>::num_nodes() {
+#  if defined(ZS_PLATFORM_LINUX)
+    static const int cnt = [] {
+      int n = 0;
+      for (auto m : online_numa_nodes()) n += __builtin_popcountl(m);
+      return n;
+    }();
+    return cnt;
+#  else
+    return 1;
+#  endif
   }
 
-  void *stack_virtual_memory_resource<host_mem_tag>::do_allocate(std::size_t bytes,
-                                                                 std::size_t alignment) {
-    _offset = (_offset + alignment - 1) / alignment * alignment;
+  int numa_memory_resource<host_mem_tag>::node_of(const void *ptr) {
+#  if defined(ZS_PLATFORM_LINUX)
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, ptr, zs_mpol_f_node | zs_mpol_f_addr) == 0)
+      return node;
+#  endif
+    return -1;
+  }
 
-    if (!reserve(_offset + bytes)) return nullptr;
+  /// huge_page_memory_resource
+  huge_page_memory_resource<host_mem_tag>::huge_page_memory_resource(ProcID did) {
+    if (did >= 0)
+      throw std::runtime_error(
+          fmt::format("huge page target device index [{}] is not negative", (int)did));
+  }
 
-    if (_offset + bytes <= _allocatedSpace) {
-      void *ret = (void *)((char *)_addr + _offset);
-      _offset += bytes;
-      return ret;
+  void *huge_page_memory_resource<host_mem_tag>::do_allocate(std::size_t bytes,
+                                                             std::size_t alignment) {
+    if (bytes == 0) return nullptr;
+    if (alignment > s_huge_page_bytes)
+      throw std::runtime_error(
+          fmt::format("huge page resource cannot align to {} bytes", alignment));
+    const std::size_t mappedBytes = round_up(bytes, s_huge_page_bytes);
+    void *ret = MAP_FAILED;
+    page_backing_e backing = page_backing_e::regular;
+#  ifdef MAP_HUGETLB
+    ret = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ret != MAP_FAILED) backing = page_backing_e::explicit_huge;
+#  endif
+    if (ret == MAP_FAILED) {
+      /// over-reserve then trim, thus the range starts on a huge page boundary
+      const std::size_t reservedBytes = mappedBytes + s_huge_page_bytes;
+      auto base = (char *)mmap(nullptr, reservedBytes, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (base == MAP_FAILED) throw std::bad_alloc{};
+      auto aligned = (char *)round_up((std::uintptr_t)base, (std::uintptr_t)s_huge_page_bytes);
+      if (aligned != base) munmap(base, aligned - base);
+      if (auto tail = base + reservedBytes - (aligned + mappedBytes); tail)
+        munmap(aligned + mappedBytes, tail);
+      ret = aligned;
+#  ifdef MADV_HUGEPAGE
+      if (madvise(ret, mappedBytes, MADV_HUGEPAGE) == 0) backing = page_backing_e::transparent_huge;
+#  endif
     }
+    switch (backing) {
+      case page_backing_e::explicit_huge:
+        _explicitBytes += mappedBytes;
+        break;
+      case page_backing_e::transparent_huge:
+        _transparentBytes += mappedBytes;
+        break;
+      default:
+        _regularBytes += mappedBytes;
+    }
+    {
+      std::lock_guard<std::mutex> lk{_mutex};
+      _backings[ret] = backing;
+    }
+    if (allocation_telemetry_enabled())
+      record_allocation(mem_host, ret, "huge_page_memory_resource", bytes, alignment);
+    return ret;
+  }
 
-    auto allocationBytes = (bytes + _granularity - 1) / _granularity * _granularity;
-    if (mprotect((char *)_addr + _allocatedSpace, allocationBytes, PROT_READ | PROT_WRITE) == 0) {
-      _allocatedSpace += allocationBytes;
-      auto ret = (char *)_addr + _offset;
-      _offset += bytes;
-      return (void *)ret;
+  void huge_page_memory_resource<host_mem_tag>::do_deallocate(void *ptr, std::size_t bytes,
+                                                              std::size_t /*alignment*/) {
+    if (ptr == nullptr || bytes == 0) return;
+    if (allocation_telemetry_enabled())
+      erase_allocation(mem_host, ptr, "huge_page_memory_resource", bytes);
+    const std::size_t mappedBytes = round_up(bytes, s_huge_page_bytes);
+    page_backing_e backing = page_backing_e::regular;
+    {
+      std::lock_guard<std::mutex> lk{_mutex};
+      if (auto it = _backings.find(ptr); it != _backings.end()) {
+        backing = it->second;
+        _backings.erase(it);
+      }
     }
-    return nullptr;
+    switch (backing) {
+      case page_backing_e::explicit_huge:
+        _explicitBytes -= mappedBytes;
+        break;
+      case page_backing_e::transparent_huge:
+        _transparentBytes -= mappedBytes;
+        break;
+      default:
+        _regularBytes -= mappedBytes;
+    }
+    munmap(ptr, mappedBytes);
   }
 
-  void stack_virtual_memory_resource<host_mem_tag>::do_deallocate(void *ptr, std::size_t bytes,
-                                                                  std::size_t alignment) {
-    auto split = ((size_t)ptr + _granularity - 1) / _granularity * _granularity;
-    if (split < (size_t)_addr) split = (size_t)_addr;
-    bytes = (split - (size_t)_addr);
-    if (bytes > _allocatedSpace) return;
-    bytes = (size_t)_allocatedSpace - bytes;
-    if (madvise((void *)split, bytes, MADV_DONTNEED) != 0) return;
-    if (mprotect((void *)split, bytes, PROT_NONE) == 0) {
-      _allocatedSpace -= bytes;
-      if (_allocatedSpace < _offset) _offset = _allocatedSpace;
+  page_backing_e huge_page_memory_resource<host_mem_tag>::backing(const void *ptr) const {
+    std::lock_guard<std::mutex> lk{_mutex};
+    if (auto it = _backings.find(ptr); it != _backings.end()) return it->second;
+    return page_backing_e::regular;
+  }
+
+  std::size_t huge_page_memory_resource<host_mem_tag>::resident_huge_bytes(const void *ptr) {
+    std::FILE *fp = std::fopen("/proc/self/smaps", "r");
+    if (fp == nullptr) return 0;
+    const auto addr = (std::uintptr_t)ptr;
+    bool inRange = false;
+    std::size_t ret = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), fp)) {
+      unsigned long st{}, ed{}, kb{};
+      /// a mapping header looks like "7f0000000000-7f0000200000 rw-p ..."
+      if (std::sscanf(line, "%lx-%lx ", &st, &ed) == 2 && std::strchr(line, '-') < line + 17) {
+        if (inRange) break;
+        inRange = st <= addr && addr < ed;
+      } else if (inRange
+                 && (std::sscanf(line, "AnonHugePages: %lu kB", &kb) == 1
+                     || std::sscanf(line, "Private_Hugetlb: %lu kB", &kb) == 1))
+        ret += (std::size_t)kb << 10;
     }
+    std::fclose(fp);
+    return ret;
   }
-#  endif  // disable this stack vmr impl
 
   arena_virtual_memory_resource<host_mem_tag>::arena_virtual_memory_resource(ProcID did,
                                                                              size_t space)
@@ -203,14 +343,17 @@ namespace zs {
   bool stack_virtual_memory_resource<host_mem_tag>::do_check_residency(std::size_t offset,
                                                                        std::size_t bytes) const {
     offset += bytes;
-    size_t ed = offset <= _reservedSpace ? round_up(offset, s_chunk_granularity) : _reservedSpace;
-    return ed <= _allocatedSpace;
+    if (offset > _reservedSpace) return false;
+    return round_up(offset, s_chunk_granularity) <= _allocatedSpace;
   }
+  /// the committed part is always a prefix [0, _allocatedSpace) of the reserved range, thus
+  /// growing never moves what is already there
   bool stack_virtual_memory_resource<host_mem_tag>::do_commit(std::size_t offset,
                                                               std::size_t bytes) {
     offset += bytes;
-    size_t ed = offset <= _reservedSpace ? round_up(offset, s_chunk_granularity) : _reservedSpace;
-    if (ed < _allocatedSpace) return true;
+    if (offset > _reservedSpace) return false;
+    size_t ed = round_up(offset, s_chunk_granularity);
+    if (ed <= _allocatedSpace) return true;
 
 #if defined(ZS_PLATFORM_WINDOWS)
     if (VirtualAlloc(_addr, ed, MEM_COMMIT, PAGE_READWRITE) == nullptr) return false;
@@ -242,14 +385,122 @@ namespace zs {
     return true;
   }
 
+  /// the whole stack is one allocation based at the start of the reserved range
   void *stack_virtual_memory_resource<host_mem_tag>::do_allocate(std::size_t bytes,
                                                                  std::size_t alignment) {
-    return nullptr;
+    if (alignment > s_chunk_granularity || !do_commit(0, bytes)) throw std::bad_alloc{};
+    return _addr;
   }
 
   void stack_virtual_memory_resource<host_mem_tag>::do_deallocate(void *ptr, std::size_t bytes,
-                                                                  std::size_t alignment) {}
+                                                                  std::size_t alignment) {
+    if (ptr == _addr) do_evict(0, _allocatedSpace);
+  }
+
 
+  /// host_memory_pool
+  namespace {
+    struct host_memory_pool_thread_cache {
+      static constexpr auto num_size_classes = host_memory_pool::num_size_classes;
+      static constexpr auto max_blocks = host_memory_pool::max_thread_cached_blocks;
+
+      ~host_memory_pool_thread_cache();
+      bool push(std::size_t cls, void *p) {
+        const auto bytes = host_memory_pool::class_bytes(cls);
+        if (cnts[cls] == max_blocks
+            || cachedBytes + bytes > host_memory_pool::max_thread_cached_bytes)
+          return false;
+        blocks[cls][cnts[cls]++] = p;
+        cachedBytes += bytes;
+        return true;
+      }
+      void *pop(std::size_t cls) {
+        if (cnts[cls] == 0) return nullptr;
+        cachedBytes -= host_memory_pool::class_bytes(cls);
+        return blocks[cls][--cnts[cls]];
+      }
+      /// returns the blocks to the shared lists
+      void flush() {
+        auto &pool = host_memory_pool::instance();
+        for (std::size_t cls = 0; cls != num_size_classes; ++cls)
+          while (cnts[cls]) {
+            void *p = pop(cls);
+            if (!pool.push_block(cls, p)) zs::deallocate(mem_host, p, 0, 0);
+          }
+      }
+
+      std::array<std::array<void *, max_blocks>, num_size_classes> blocks{};
+      std::array<unsigned char, num_size_classes> cnts{};
+      std::size_t cachedBytes{0};
+    };
+    thread_local host_memory_pool_thread_cache t_hostPoolCache{};
+    /// trivially destructible, thus still readable when containers die during thread exit
+    thread_local bool t_hostPoolCacheExpired = false;
+    host_memory_pool_thread_cache::~host_memory_pool_thread_cache() {
+      t_hostPoolCacheExpired = true;
+      flush();
+    }
+  }  // namespace
+
+  bool host_memory_pool::push_block(std::size_t cls, void *p) {
+    const auto bytes = class_bytes(cls);
+    if (_cachedBytes.fetch_add(bytes) + bytes > _maxCachedBytes.load()) {
+      _cachedBytes -= bytes;
+      return false;
+    }
+    std::lock_guard<std::mutex> lk{_locks[cls]};
+    _blocks[cls].push_back(p);
+    return true;
+  }
+  void *host_memory_pool::pop_block(std::size_t cls) {
+    void *ret = nullptr;
+    {
+      std::lock_guard<std::mutex> lk{_locks[cls]};
+      if (_blocks[cls].empty()) return nullptr;
+      ret = _blocks[cls].back();
+      _blocks[cls].pop_back();
+    }
+    _cachedBytes -= class_bytes(cls);
+    return ret;
+  }
+  void *host_memory_pool::allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes == 0) return nullptr;
+    if (!is_pooled(bytes, alignment)) return zs::allocate(mem_host, bytes, alignment);
+    const auto cls = size_class(bytes);
+    if (!t_hostPoolCacheExpired)
+      if (void *p = t_hostPoolCache.pop(cls); p) return p;
+    if (void *p = pop_block(cls); p) return p;
+    /// aligned_alloc expects a multiple of the alignment
+    const auto blockBytes = round_up(class_bytes(cls), block_alignment);
+    void *ret = zs::allocate(mem_host, blockBytes, block_alignment);
+    if (ret == nullptr) {
+      /// cached blocks of other classes may be what stands in the way
+      release();
+      ret = zs::allocate(mem_host, blockBytes, block_alignment);
+      if (ret == nullptr) throw std::bad_alloc{};
+    }
+    return ret;
+  }
+  void host_memory_pool::deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+    if (p == nullptr || bytes == 0) return;
+    if (!is_pooled(bytes, alignment)) return zs::deallocate(mem_host, p, bytes, alignment);
+    const auto cls = size_class(bytes);
+    if (!t_hostPoolCacheExpired && t_hostPoolCache.push(cls, p)) return;
+    if (push_block(cls, p)) return;
+    zs::deallocate(mem_host, p, class_bytes(cls), block_alignment);
+  }
+  void host_memory_pool::release() {
+    if (!t_hostPoolCacheExpired) t_hostPoolCache.flush();
+    for (std::size_t cls = 0; cls != num_size_classes; ++cls) {
+      std::vector<void *> blocks{};
+      {
+        std::lock_guard<std::mutex> lk{_locks[cls]};
+        blocks.swap(_blocks[cls]);
+      }
+      _cachedBytes -= class_bytes(cls) * blocks.size();
+      for (void *p : blocks) zs::deallocate(mem_host, p, class_bytes(cls), block_alignment);
+    }
+  }
 
   /// handle_resource
   handle_resource::handle_resource(mr_t *upstream) noexcept : _upstream{upstream} {}
@@ -325,4 +576,59 @@ namespace zs {
     _head = (char *)p;
   }
 
+  /// scratch arena
+  scratch_arena &scratch_arena::thread_local_instance() {
+    thread_local scratch_arena arena{};
+    return arena;
+  }
+  namespace {
+    /// offset of the first address past ptr + offset aligned to alignment
+    std::size_t aligned_offset(const char *ptr, std::size_t offset, std::size_t alignment) {
+      const auto addr = (std::uintptr_t)ptr + offset;
+      return (addr + alignment - 1) / alignment * alignment - (std::uintptr_t)ptr;
+    }
+  }  // namespace
+  scratch_arena::~scratch_arena() {
+    for (auto &chunk : _chunks)
+      zs::deallocate(mem_host, chunk.ptr, chunk.bytes, alignof(std::max_align_t));
+  }
+  void *scratch_arena::acquire_bytes(std::size_t bytes, std::size_t alignment) {
+    for (; _cur < _chunks.size(); ++_cur, _offset = 0) {
+      const auto &chunk = _chunks[_cur];
+      const auto st = aligned_offset(chunk.ptr, _offset, alignment);
+      if (st + bytes <= chunk.bytes) {
+        _offset = st + bytes;
+        return chunk.ptr + st;
+      }
+    }
+    /// no chunk left with enough room
+    std::size_t chunkBytes = std::max(min_chunk_bytes, bytes + alignment);
+    if (!_chunks.empty()) chunkBytes = std::max(chunkBytes, _chunks.back().bytes * 2);
+    chunkBytes = round_up(chunkBytes, min_chunk_bytes);
+    auto ptr = (char *)zs::allocate(mem_host, chunkBytes, alignof(std::max_align_t));
+    if (ptr == nullptr) throw std::bad_alloc{};
+    _chunks.push_back(chunk_t{ptr, chunkBytes});
+    _cur = _chunks.size() - 1;
+    const auto st = aligned_offset(ptr, 0, alignment);
+    _offset = st + bytes;
+    return ptr + st;
+  }
+  std::size_t scratch_arena::reserved_bytes() const noexcept {
+    std::size_t ret = 0;
+    for (auto &chunk : _chunks) ret += chunk.bytes;
+    return ret;
+  }
+  void scratch_arena::rewind(std::size_t chunk, std::size_t offset) {
+    _cur = chunk;
+    _offset = offset;
+    if (--_depth == 0 && _chunks.size() > 1) {
+      const auto totalBytes = reserved_bytes();
+      for (auto &c : _chunks) zs::deallocate(mem_host, c.ptr, c.bytes, alignof(std::max_align_t));
+      _chunks.clear();
+      _cur = _offset = 0;
+      auto ptr = (char *)zs::allocate(mem_host, totalBytes, alignof(std::max_align_t));
+      if (ptr != nullptr) _chunks.push_back(chunk_t{ptr, totalBytes});
+    }
+  }
+
 }  // namespace zs
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "MemOps.hpp"
@@ -13,6 +18,14 @@
 
 namespace zs {
 
+  /// allocation telemetry hooks of the resources below (see Resource::telemetry)
+  /// recording only happens while it is enabled, otherwise they cost one atomic load
+  ZPC_API bool allocation_telemetry_enabled() noexcept;
+  ZPC_API void record_allocation(mem_tags tag, void *ptr, std::string_view allocator,
+                                 std::size_t size, std::size_t alignment);
+  ZPC_API void erase_allocation(mem_tags tag, void *ptr, std::string_view allocator,
+                                std::size_t size);
+
   template <typename MemTag> struct raw_memory_resource : mr_t,
                                                           Singleton<raw_memory_resource<MemTag>> {
     using value_type = std::byte;
@@ -25,15 +38,17 @@ namespace zs {
     void *do_allocate(std::size_t bytes, std::size_t alignment) override {
       if (bytes) {
         auto ret = zs::allocate(MemTag{}, bytes, alignment);
-        // record_allocation(MemTag{}, ret, demangle(*this), bytes, alignment);
+        if (allocation_telemetry_enabled())
+          record_allocation(MemTag{}, ret, "raw_memory_resource", bytes, alignment);
         return ret;
       }
       return nullptr;
     }
     void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override {
       if (bytes) {
+        if (allocation_telemetry_enabled())
+          erase_allocation(MemTag{}, ptr, "raw_memory_resource", bytes);
         zs::deallocate(MemTag{}, ptr, bytes, alignment);
-        // erase_allocation(ptr);
       }
     }
     bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
@@ -80,6 +95,158 @@ namespace zs {
     ProcID did;
   };
 
+  /// process-wide cache of host blocks grouped into size classes (four per power of two, thus at
+  /// most 25% internal waste), freed blocks are kept for reuse rather than returned to the system
+  /// so that recurring temporaries skip both the allocator and the page faults of fresh memory
+  /// a freed block first goes to a small per-thread cache, then to the shared per-class lists
+  struct ZPC_API host_memory_pool : Singleton<host_memory_pool> {
+    static constexpr std::size_t min_block_bits = 8;
+    static constexpr std::size_t max_block_bits = 30;
+    static constexpr std::size_t num_subclasses = 4;
+    static constexpr std::size_t num_size_classes
+        = 1 + (max_block_bits - min_block_bits) * num_subclasses;
+    /// requests asking for a stricter alignment bypass the pool
+    static constexpr std::size_t block_alignment = 256;
+    /// per-thread cache limits
+    static constexpr std::size_t max_thread_cached_blocks = 4;
+    static constexpr std::size_t max_thread_cached_bytes = (std::size_t)1 << 26;
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+      if (bytes <= ((std::size_t)1 << min_block_bits)) return 0;
+      const std::size_t k = bit_count(bytes) - 1;  // 2^k < bytes <= 2^(k + 1)
+      const std::size_t step = (std::size_t)1 << (k - 2);
+      const std::size_t j = (bytes - ((std::size_t)1 << k) + step - 1) / step;
+      return 1 + (k - min_block_bits) * num_subclasses + (j - 1);
+    }
+    static constexpr std::size_t class_bytes(std::size_t cls) noexcept {
+      if (cls == 0) return (std::size_t)1 << min_block_bits;
+      const std::size_t k = min_block_bits + (cls - 1) / num_subclasses;
+      const std::size_t j = (cls - 1) % num_subclasses + 1;
+      return ((std::size_t)1 << k) + j * ((std::size_t)1 << (k - 2));
+    }
+    static constexpr bool is_pooled(std::size_t bytes, std::size_t alignment) noexcept {
+      return bytes <= ((std::size_t)1 << max_block_bits) && alignment <= block_alignment;
+    }
+
+    void *allocate(std::size_t bytes, std::size_t alignment);
+    void deallocate(void *p, std::size_t bytes, std::size_t alignment);
+    /// hands every block cached in the shared lists and by the calling thread back to the system
+    void release();
+    std::size_t cached_bytes() const noexcept { return _cachedBytes.load(); }
+    /// blocks freed beyond this budget (shared lists only) go back to the system
+    void set_max_cached_bytes(std::size_t bytes) noexcept { _maxCachedBytes = bytes; }
+
+    /// called by the per-thread caches
+    bool push_block(std::size_t cls, void *p);
+    void *pop_block(std::size_t cls);
+
+  protected:
+    std::array<std::vector<void *>, num_size_classes> _blocks{};
+    std::array<std::mutex, num_size_classes> _locks{};
+    std::atomic<std::size_t> _cachedBytes{0};
+    std::atomic<std::size_t> _maxCachedBytes{(std::size_t)1 << 32};
+  };
+
+  /// pooling is only available for host memory for now, others go upstream directly
+  template <typename MemTag> struct pooled_memory_resource : default_memory_resource<MemTag> {
+    pooled_memory_resource(ProcID did = 0) : default_memory_resource<MemTag>{did} {}
+  };
+  template <> struct pooled_memory_resource<host_mem_tag> : mr_t {
+    pooled_memory_resource(ProcID /*did*/ = -1) : _pool{&host_memory_pool::instance()} {}
+    ~pooled_memory_resource() = default;
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+      void *ret = _pool->allocate(bytes, alignment);
+      if (ret && allocation_telemetry_enabled())
+        record_allocation(mem_host, ret, "pooled_memory_resource", bytes, alignment);
+      return ret;
+    }
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override {
+      if (ptr && allocation_telemetry_enabled())
+        erase_allocation(mem_host, ptr, "pooled_memory_resource", bytes);
+      _pool->deallocate(ptr, bytes, alignment);
+    }
+    /// every instance draws from the same pool
+    bool do_is_equal(const mr_t &other) const noexcept override {
+      if (auto o = dynamic_cast<const pooled_memory_resource *>(&other); o)
+        return _pool == o->_pool;
+      return false;
+    }
+
+  private:
+    host_memory_pool *_pool;
+  };
+
+  /// how a host range obtained from huge_page_memory_resource is backed
+  enum struct page_backing_e : char { regular = 0, transparent_huge, explicit_huge };
+
+  /// huge pages are only requested for host memory for now, others go upstream directly
+  template <typename MemTag> struct huge_page_memory_resource : default_memory_resource<MemTag> {
+    huge_page_memory_resource(ProcID did = 0) : default_memory_resource<MemTag>{did} {}
+  };
+#ifdef ZS_PLATFORM_UNIX
+  /// maps whole 2MB pages, preferably from the hugetlb pool (MAP_HUGETLB), otherwise 2MB-aligned
+  /// regular pages advised to be backed by transparent huge pages (MADV_HUGEPAGE)
+  /// fewer TLB misses for large randomly accessed buffers (e.g. hash tables, sparse grids)
+  template <> struct huge_page_memory_resource<host_mem_tag> : mr_t {
+    static constexpr std::size_t s_huge_page_bytes = vmr_t::s_chunk_granularity;
+
+    huge_page_memory_resource(ProcID did = -1);
+    ~huge_page_memory_resource() = default;
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
+
+    /// what was requested for the range starting at ptr
+    page_backing_e backing(const void *ptr) const;
+    /// bytes currently held per backing
+    std::size_t explicit_huge_bytes() const noexcept { return _explicitBytes.load(); }
+    std::size_t transparent_huge_bytes() const noexcept { return _transparentBytes.load(); }
+    std::size_t regular_bytes() const noexcept { return _regularBytes.load(); }
+    /// bytes of the mapping containing ptr the kernel actually backs by huge pages right now
+    /// (from /proc/self/smaps), transparent huge pages are only assembled once touched
+    static std::size_t resident_huge_bytes(const void *ptr);
+
+  private:
+    mutable std::mutex _mutex{};
+    std::unordered_map<const void *, page_backing_e> _backings{};
+    std::atomic<std::size_t> _explicitBytes{0}, _transparentBytes{0}, _regularBytes{0};
+  };
+#endif
+
+  /// where the pages of a host range obtained from numa_memory_resource are placed
+  ///   first_touch: left unplaced, each page lands on the node of the thread touching it first
+  ///   interleave: round-robin over all online nodes
+  ///   bind: all on one node (the ProcID)
+  enum struct numa_placement_e : char { first_touch = 0, interleave, bind };
+
+  /// only host memory is numa placed for now, others go upstream directly
+  template <typename MemTag> struct numa_memory_resource : default_memory_resource<MemTag> {
+    numa_memory_resource(ProcID did = 0, numa_placement_e = numa_placement_e::first_touch)
+        : default_memory_resource<MemTag>{did} {}
+  };
+#ifdef ZS_PLATFORM_UNIX
+  /// page-granular mappings whose physical placement follows a numa policy (linux only, the
+  /// placement degrades to first_touch elsewhere). pair first_touch with a parallel first touch
+  /// (e.g. Vector::reset with an OmpExecutionPolicy) so pages end up near their later users
+  template <> struct numa_memory_resource<host_mem_tag> : mr_t {
+    numa_memory_resource(ProcID node = -1,
+                         numa_placement_e placement = numa_placement_e::first_touch);
+    ~numa_memory_resource() = default;
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
+
+    /// number of online numa nodes (1 when unknown)
+    static int num_nodes();
+    /// the node the page containing ptr currently resides on, -1 if not yet faulted in or unknown
+    static int node_of(const void *ptr);
+
+    ProcID _node;
+    numa_placement_e _placement;
+    std::size_t _granularity;
+  };
+#endif
+
   template <typename MemTag> struct stack_virtual_memory_resource
       : vmr_t {  // default impl falls back to
     template <typename... Args> stack_virtual_memory_resource(Args...) {
@@ -149,24 +316,8 @@ namespace zs {
     bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
   };
 
-#if 0
-  template <> struct stack_virtual_memory_resource<host_mem_tag>
-      : vmr_t {  // default impl falls back to
-    stack_virtual_memory_resource(ProcID did = -1, std::string_view type = "HOST_VIRTUAL");
-    ~stack_virtual_memory_resource();
-    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
-    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
-    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
-
-    bool reserve(std::size_t desiredSpace);
-
-    std::string _type;
-    size_t _granularity;
-    void *_addr;
-    size_t _offset, _allocatedSpace, _reservedSpace;
-    ProcID _did;
-  };
-#else
+  /// reserves the address range upfront and commits/decommits a growing prefix of it, thus
+  /// containers on top of it (e.g. Vector<T, ZSPmrAllocator<true>>) grow in place without copying
   template <> struct stack_virtual_memory_resource<host_mem_tag>
       : vmr_t {  // default impl falls back to
     stack_virtual_memory_resource(ProcID did = -1, std::size_t size = vmr_t::s_chunk_granularity);
@@ -188,8 +339,6 @@ namespace zs {
     ProcID _did;
   };
 
-#endif
-
 #ifdef ZS_PLATFORM_WINDOWS
 #elif defined(ZS_PLATFORM_UNIX)
 
@@ -1,5 +1,14 @@
 #include "MemOps.hpp"
 
+#include <algorithm>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define ZS_HOST_STREAMING_STORES 1
+#else
+#  define ZS_HOST_STREAMING_STORES 0
+#endif
+
 namespace zs {
 
   void *allocate(host_mem_tag, std::size_t size, std::size_t alignment,
@@ -21,10 +30,62 @@ namespace zs {
 #endif
   }
   void memset(host_mem_tag, void *addr, int chval, std::size_t size, const source_location &loc) {
-    std::memset(addr, chval, size);
+    if (size >= host_streaming_threshold_bytes)
+      memset_streaming(mem_host, addr, chval, size);
+    else
+      std::memset(addr, chval, size);
   }
   void copy(host_mem_tag, void *dst, void *src, std::size_t size, const source_location &loc) {
+    if (size >= host_streaming_threshold_bytes)
+      copy_streaming(mem_host, dst, src, size);
+    else
+      std::memcpy(dst, src, size);
+  }
+
+  /// streaming stores need 16-byte aligned destinations, the unaligned head and the tail go
+  /// through the regular path
+  void copy_streaming(host_mem_tag, void *dst, const void *src, std::size_t size) {
+#if ZS_HOST_STREAMING_STORES
+    auto d = static_cast<char *>(dst);
+    auto s = static_cast<const char *>(src);
+    const std::size_t head = std::min((16 - ((std::uintptr_t)d & 15)) & 15, size);
+    std::memcpy(d, s, head);
+    d += head, s += head, size -= head;
+    for (; size >= 64; d += 64, s += 64, size -= 64) {
+      const __m128i v0 = _mm_loadu_si128((const __m128i *)s);
+      const __m128i v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+      const __m128i v2 = _mm_loadu_si128((const __m128i *)(s + 32));
+      const __m128i v3 = _mm_loadu_si128((const __m128i *)(s + 48));
+      _mm_stream_si128((__m128i *)d, v0);
+      _mm_stream_si128((__m128i *)(d + 16), v1);
+      _mm_stream_si128((__m128i *)(d + 32), v2);
+      _mm_stream_si128((__m128i *)(d + 48), v3);
+    }
+    /// streaming stores are weakly ordered
+    _mm_sfence();
+    std::memcpy(d, s, size);
+#else
     std::memcpy(dst, src, size);
+#endif
+  }
+  void memset_streaming(host_mem_tag, void *addr, int chval, std::size_t size) {
+#if ZS_HOST_STREAMING_STORES
+    auto d = static_cast<char *>(addr);
+    const std::size_t head = std::min((16 - ((std::uintptr_t)d & 15)) & 15, size);
+    std::memset(d, chval, head);
+    d += head, size -= head;
+    const __m128i v = _mm_set1_epi8((char)chval);
+    for (; size >= 64; d += 64, size -= 64) {
+      _mm_stream_si128((__m128i *)d, v);
+      _mm_stream_si128((__m128i *)(d + 16), v);
+      _mm_stream_si128((__m128i *)(d + 32), v);
+      _mm_stream_si128((__m128i *)(d + 48), v);
+    }
+    _mm_sfence();
+    std::memset(d, chval, size);
+#else
+    std::memset(addr, chval, size);
+#endif
   }
 
 }  // namespace zs
\ No newline at end of file
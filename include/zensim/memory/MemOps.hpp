@@ -16,6 +16,15 @@ namespace zs {
   void copy(host_mem_tag, void *dst, void *src, std::size_t size,
             const source_location &loc = source_location::current());
 
+  /// host transfers below this stay on one thread when issued through a parallel policy
+  constexpr std::size_t host_parallel_transfer_threshold_bytes = (std::size_t)1 << 20;
+  /// host transfers beyond this (roughly a last-level cache) bypass the caches with streaming
+  /// stores, which would otherwise only evict the working set without ever being read back
+  constexpr std::size_t host_streaming_threshold_bytes = (std::size_t)1 << 23;
+  /// non-temporal kernels (plain memcpy/memset where streaming stores are unavailable)
+  void copy_streaming(host_mem_tag, void *dst, const void *src, std::size_t size);
+  void memset_streaming(host_mem_tag, void *addr, int chval, std::size_t size);
+
 #if 0
   /// dispatch mem op calls
   void *allocate_dispatch(mem_tags tag, std::size_t size, std::size_t alignment);
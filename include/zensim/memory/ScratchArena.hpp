@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "zensim/Platform.hpp"
+
+namespace zs {
+
+  /// reusable bump allocator for the temporaries of host parallel algorithms, memory obtained
+  /// within a scope is handed back (not freed) when the scope closes, thus once warmed up the
+  /// recurring small buffers (per-thread partials, histograms) cost no allocation at all
+  struct ZPC_API scratch_arena {
+    static constexpr std::size_t min_chunk_bytes = (std::size_t)1 << 16;
+
+    struct scope {
+      explicit scope(scratch_arena &arena) noexcept
+          : _arena{arena}, _chunk{arena._cur}, _offset{arena._offset} {
+        ++_arena._depth;
+      }
+      scope(const scope &) = delete;
+      scope &operator=(const scope &) = delete;
+      ~scope() { _arena.rewind(_chunk, _offset); }
+
+      /// value-initialized storage for n elements, valid until the scope closes
+      template <typename T> T *acquire(std::size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "scratch elements are never destroyed individually!");
+        T *ret = static_cast<T *>(_arena.acquire_bytes(sizeof(T) * n, alignof(T)));
+        for (std::size_t i = 0; i != n; ++i) new (ret + i) T{};
+        return ret;
+      }
+
+    private:
+      scratch_arena &_arena;
+      std::size_t _chunk, _offset;
+    };
+
+    scratch_arena() = default;
+    scratch_arena(const scratch_arena &) = delete;
+    scratch_arena &operator=(const scratch_arena &) = delete;
+    ~scratch_arena();
+
+    /// the arena of the calling thread
+    static scratch_arena &thread_local_instance();
+
+    void *acquire_bytes(std::size_t bytes, std::size_t alignment);
+    std::size_t reserved_bytes() const noexcept;
+
+  protected:
+    struct chunk_t {
+      char *ptr;
+      std::size_t bytes;
+    };
+    /// merges the chunks into one once the outermost scope closes
+    void rewind(std::size_t chunk, std::size_t offset);
+
+    std::vector<chunk_t> _chunks{};
+    std::size_t _cur{0}, _offset{0}, _depth{0};
+  };
+
+}  // namespace zs
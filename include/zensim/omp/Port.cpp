@@ -1,11 +1,24 @@
 #include "Port.hpp"
 
+#include <cstdlib>
+#include <string_view>
+
 #include "execution/ExecutionPolicy.hpp"
 #include "zensim/memory/Allocator.h"
 
 namespace zs {
 
-  bool initialize_backend(omp_exec_tag) { return true; }
+  bool initialize_backend(omp_exec_tag) {
+    /// same team width as omp_exec()
+    if (const char *binding = std::getenv("ZS_OMP_THREAD_BINDING")) {
+      const std::string_view opt{binding};
+      if (opt == "compact")
+        pin_omp_threads(get_hardware_concurrency() - 1, omp_thread_binding_e::compact);
+      else if (opt == "scatter")
+        pin_omp_threads(get_hardware_concurrency() - 1, omp_thread_binding_e::scatter);
+    }
+    return true;
+  }
   bool deinitialize_backend(omp_exec_tag) { return true; }
 
 }  // namespace zs
\ No newline at end of file
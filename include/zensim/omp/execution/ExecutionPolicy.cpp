@@ -1,8 +1,85 @@
 #include "ExecutionPolicy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <thread>
+#include <tuple>
+#include <vector>
+#if defined(ZS_PLATFORM_LINUX)
+#  include <sched.h>
+#endif
 
 namespace zs {
 
   uint get_hardware_concurrency() noexcept { return std::thread::hardware_concurrency(); }
 
+#if defined(ZS_PLATFORM_LINUX)
+  namespace {
+    int read_cpu_topology(int cpu, const char *entry) {
+      char path[128];
+      std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, entry);
+      int ret = 0;
+      if (std::FILE *fp = std::fopen(path, "r")) {
+        if (std::fscanf(fp, "%d", &ret) != 1) ret = 0;
+        std::fclose(fp);
+      }
+      return ret;
+    }
+  }  // namespace
+#endif
+
+  bool pin_omp_threads(int numThreads, omp_thread_binding_e binding) {
+    if (binding == omp_thread_binding_e::none || numThreads <= 0) return true;
+    /// OMP_PROC_BIND/OMP_PLACES already have the runtime bind its threads
+    if (omp_get_proc_bind() != omp_proc_bind_false) return true;
+#if defined(ZS_PLATFORM_LINUX)
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+    struct cpu_t {
+      int id, socket, core, smt, local;
+    };
+    std::vector<cpu_t> cpus;
+    for (int i = 0; i < CPU_SETSIZE; ++i)
+      if (CPU_ISSET(i, &allowed))
+        cpus.push_back(cpu_t{i, read_cpu_topology(i, "physical_package_id"),
+                             read_cpu_topology(i, "core_id"), 0, 0});
+    if (cpus.empty()) return false;
+    /// smt: rank among the hyperthread siblings of a core
+    std::sort(cpus.begin(), cpus.end(), [](const cpu_t &a, const cpu_t &b) {
+      return std::tie(a.socket, a.core, a.id) < std::tie(b.socket, b.core, b.id);
+    });
+    for (std::size_t i = 1; i < cpus.size(); ++i)
+      if (cpus[i].socket == cpus[i - 1].socket && cpus[i].core == cpus[i - 1].core)
+        cpus[i].smt = cpus[i - 1].smt + 1;
+    /// compact: socket by socket, every physical core before any of their siblings
+    std::sort(cpus.begin(), cpus.end(), [](const cpu_t &a, const cpu_t &b) {
+      return std::tie(a.socket, a.smt, a.core, a.id) < std::tie(b.socket, b.smt, b.core, b.id);
+    });
+    for (std::size_t i = 1; i < cpus.size(); ++i)
+      if (cpus[i].socket == cpus[i - 1].socket) cpus[i].local = cpus[i - 1].local + 1;
+    /// scatter: the k-th cpu of every socket before the (k+1)-th of any
+    if (binding == omp_thread_binding_e::scatter)
+      std::sort(cpus.begin(), cpus.end(), [](const cpu_t &a, const cpu_t &b) {
+        return std::tie(a.local, a.socket) < std::tie(b.local, b.socket);
+      });
+
+    /// the calling thread keeps its mask, since it outlives the team and every std::thread it
+    /// spawns later would inherit a single-cpu mask
+    std::atomic<bool> pinned{true};
+#  pragma omp parallel num_threads(numThreads)
+    {
+      if (const int tid = omp_get_thread_num(); tid != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[tid % cpus.size()].id, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) pinned = false;
+      }
+    }
+    return pinned;
+#else
+    return false;
+#endif
+  }
+
 }  // namespace zs
\ No newline at end of file
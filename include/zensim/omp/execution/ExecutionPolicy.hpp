@@ -11,8 +11,14 @@
 
 #include <omp.h>
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
 #include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/math/bit/Bits.h"
+#include "zensim/memory/MemOps.hpp"
 #include "zensim/types/Function.h"
 #include "zensim/types/Iterator.h"
 #include "zensim/types/SourceLocation.hpp"
@@ -31,16 +37,18 @@ namespace zs {
       constexpr auto dim = Collapse<Ts, Is>::dim;
       CppTimer timer;
       if (shouldProfile()) timer.tick();
+      scoped_schedule sched{_schedule, _chunk};
       if constexpr (dim == 1) {
-#pragma omp parallel for if (_dop < dims.get(0_th)) num_threads(_dop)
+#pragma omp parallel for if (_dop < dims.get(0_th)) num_threads(_dop) schedule(runtime)
         for (RM_CVREF_T(dims.get(0_th)) i = 0; i < dims.get(0_th); ++i) std::invoke(f, i);
       } else if constexpr (dim == 2) {
-#pragma omp parallel for collapse(2) if (_dop < dims.get(0_th) * dims.get(1_th)) num_threads(_dop)
+#pragma omp parallel for collapse(2) if (_dop < dims.get(0_th) * dims.get(1_th)) num_threads(_dop) \
+    schedule(runtime)
         for (RM_CVREF_T(dims.get(0_th)) i = 0; i < dims.get(0_th); ++i)
           for (RM_CVREF_T(dims.get(1_th)) j = 0; j < dims.get(1_th); ++j) std::invoke(f, i, j);
       } else if constexpr (dim == 3) {
 #pragma omp parallel for collapse(3) if (_dop < dims.get(0_th) * dims.get(1_th) * dims.get(2_th)) \
-    num_threads(_dop)
+    num_threads(_dop) schedule(runtime)
         for (RM_CVREF_T(dims.get(0_th)) i = 0; i < dims.get(0_th); ++i)
           for (RM_CVREF_T(dims.get(1_th)) j = 0; j < dims.get(1_th); ++j)
             for (RM_CVREF_T(dims.get(2_th)) k = 0; k < dims.get(2_th); ++k) std::invoke(f, i, j, k);
@@ -65,15 +73,26 @@ namespace zs {
         /// for iterator-like range (e.g. openvdb)
         /// for openvdb parallel iteration...
         auto iter = FWD(range);  // otherwise fails on win
+        if (_stealGrain) {
+          steal_chunks(
+              iter, [](const auto &it) { return (bool)it; }, [](auto &it) { ++it; },
+              [&f](auto &it) {
+                if constexpr (std::is_invocable_v<F>)
+                  f();
+                else
+                  std::invoke(f, it);
+              });
+        } else {
 #pragma omp parallel num_threads(_dop)
 #pragma omp master
-        for (; iter; ++iter)
+          for (; iter; ++iter)
 #pragma omp task firstprivate(iter)
-        {
-          if constexpr (std::is_invocable_v<F>) {
-            f();
-          } else {
-            std::invoke(f, iter);
+          {
+            if constexpr (std::is_invocable_v<F>) {
+              f();
+            } else {
+              std::invoke(f, iter);
+            }
           }
         }
       } else {
@@ -86,7 +105,8 @@ namespace zs {
           auto iter = std::begin(range);
           const DiffT dist = std::end(range) - iter;
 
-#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+          scoped_schedule sched{_schedule, _chunk};
+#pragma omp parallel for if (_dop < dist) num_threads(_dop) schedule(runtime)
           for (DiffT i = 0; i < dist; ++i) {
             if constexpr (std::is_invocable_v<F>)
               f();
@@ -98,6 +118,23 @@ namespace zs {
                 std::invoke(f, it);
             }
           }
+        } else if (_stealGrain) {
+          // forward iterator category
+          auto ed = std::end(range);
+          steal_chunks(
+              std::begin(range), [&ed](const auto &it) { return it != ed; },
+              [](auto &it) { ++it; },
+              [&f](auto &iter) {
+                if constexpr (std::is_invocable_v<F>)
+                  f();
+                else {
+                  auto &&it = *iter;
+                  if constexpr (is_std_tuple<remove_cvref_t<decltype(it)>>::value)
+                    std::apply(f, it);
+                  else
+                    std::invoke(f, it);
+                }
+              });
         } else {
           // forward iterator category
 #pragma omp parallel num_threads(_dop)
@@ -129,7 +166,22 @@ namespace zs {
       // using Range = zs::select_indexed_type<I, std::decay_t<Ranges>...>;
       const auto &range = zs::get<I>(ranges);
       auto ed = range.end();
-      if constexpr (I + 1 == sizeof...(Ranges)) {
+      if (_stealGrain) {
+        steal_chunks(
+            range.begin(), [&ed](const auto &iter) { return iter != ed; },
+            [](auto &iter) { ++iter; },
+            [&](auto &iter) {
+              auto &&it = *iter;
+              if constexpr (I + 1 == sizeof...(Ranges)) {
+                const auto args
+                    = shuffle(indices, std::tuple_cat(prefixIters, std::make_tuple(it)));
+                (std::apply(FWD(bodies), args), ...);
+              } else
+                zs::get<I + 1>(policies).template exec<I + 1>(
+                    indices, std::tuple_cat(prefixIters, std::make_tuple(it)), policies, ranges,
+                    bodies...);
+            });
+      } else if constexpr (I + 1 == sizeof...(Ranges)) {
 #pragma omp parallel num_threads(_dop)
 #pragma omp master
         for (auto &&it : range)
@@ -182,16 +234,16 @@ namespace zs {
       CppTimer timer;
       if (shouldProfile()) timer.tick();
       const auto dist = last - first;
-      std::vector<ValueT> localRes{};
+      /// the team is capped at maxThreads (a non-positive _dop would follow OMP_NUM_THREADS)
+      const int maxThreads = std::max(_dop, 1);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      ValueT *localRes = scratch.acquire<ValueT>(maxThreads);
       DiffT nths{};
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads) \
     shared(dist, nths, first, last, d_first, localRes, binary_op)
       {
 #pragma omp single
-        {
-          nths = omp_get_num_threads();
-          localRes.resize(nths);
-        }
+        { nths = omp_get_num_threads(); }
 #pragma omp barrier
         DiffT tid = omp_get_thread_num();
         DiffT nwork = (dist + nths - 1) / nths;
@@ -260,16 +312,16 @@ namespace zs {
       CppTimer timer;
       if (shouldProfile()) timer.tick();
       const auto dist = last - first;
-      std::vector<ValueT> localRes{};
+      /// the team is capped at maxThreads (a non-positive _dop would follow OMP_NUM_THREADS)
+      const int maxThreads = std::max(_dop, 1);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      ValueT *localRes = scratch.acquire<ValueT>(maxThreads);
       DiffT nths{};
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads) \
     shared(dist, nths, first, last, d_first, localRes, binary_op)
       {
 #pragma omp single
-        {
-          nths = omp_get_num_threads();
-          localRes.resize(nths);
-        }
+        { nths = omp_get_num_threads(); }
 #pragma omp barrier
         DiffT tid = omp_get_thread_num();
         DiffT nwork = (dist + nths - 1) / nths;
@@ -338,19 +390,23 @@ namespace zs {
       CppTimer timer;
       if (shouldProfile()) timer.tick();
       const auto dist = last - first;
-      std::vector<ValueT> localRes{};
-      DiffT nths{}, n{};
-#pragma omp parallel if (_dop < dist) num_threads(_dop) shared(dist, nths, first, last, d_first)
+      /// the team is capped at maxThreads (a non-positive _dop would follow OMP_NUM_THREADS)
+      const int maxThreads = std::max(_dop, 1);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      ValueT *localRes = scratch.acquire<ValueT>(maxThreads);
+      DiffT nths{}, nwork{}, n{};
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads) \
+    shared(dist, nths, nwork, n, first, last, d_first)
       {
 #pragma omp single
         {
           nths = omp_get_num_threads();
-          n = nths < dist ? nths : dist;
-          localRes.resize(nths);
+          nwork = (dist + nths - 1) / nths;
+          /// the number of non-empty blocks
+          n = nwork ? (dist + nwork - 1) / nwork : 0;
         }
 #pragma omp barrier
         DiffT tid = omp_get_thread_num();
-        DiffT nwork = (dist + nths - 1) / nths;
         DiffT st = nwork * tid;
         DiffT ed = st + nwork;
         if (ed > dist) ed = dist;
@@ -371,7 +427,7 @@ namespace zs {
 #pragma omp barrier
         }
 
-        if (tid == 0) *d_first = res;
+        if (tid == 0) *d_first = n ? binary_op(init, tmp) : init;
       }
       if (shouldProfile())
         timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
@@ -414,9 +470,13 @@ namespace zs {
       constexpr int binBits = 8;  // by byte
       int binCount = 1 << binBits;
       int binMask = binCount - 1;
-      std::vector<std::vector<DiffT>> binSizes{};
-      std::vector<DiffT> binGlobalSizes(binCount);
-      std::vector<DiffT> binOffsets(binCount);
+      /// per-thread histograms, the team is capped at maxThreads
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      const int maxThreads = std::max(_dop, 1);
+      DiffT **binSizes = scratch.acquire<DiffT *>(maxThreads);
+      for (int t = 0; t != maxThreads; ++t) binSizes[t] = scratch.acquire<DiffT>(binCount);
+      DiffT *binGlobalSizes = scratch.acquire<DiffT>(binCount);
+      DiffT *binOffsets = scratch.acquire<DiffT>(binCount);
 
       /// double buffer strategy
       std::vector<InputValueT> buffers[2];
@@ -441,14 +501,13 @@ namespace zs {
         }
 
         /// init
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads) \
     shared(skip, nths, nwork, binSizes, binGlobalSizes, binOffsets, cur, next)
         {
 #pragma omp single
           {
             nths = omp_get_num_threads();
             nwork = (dist + nths - 1) / nths;
-            binSizes.resize(nths);
             skip = false;
           }
 #pragma omp barrier
@@ -457,9 +516,6 @@ namespace zs {
           DiffT l = nwork * tid;
           DiffT r = l + nwork;
           if (r > dist) r = dist;
-          /// init
-          binSizes[tid].resize(binCount);
-
           /// local count
           for (DiffT i = 0; i < binCount; ++i) binSizes[tid][i] = 0;
           if (l < dist)
@@ -552,9 +608,13 @@ namespace zs {
       constexpr int binBits = 8;  // by byte
       int binCount = 1 << binBits;
       int binMask = binCount - 1;
-      std::vector<std::vector<DiffT>> binSizes{};
-      std::vector<DiffT> binGlobalSizes(binCount);
-      std::vector<DiffT> binOffsets(binCount);
+      /// per-thread histograms, the team is capped at maxThreads
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      const int maxThreads = std::max(_dop, 1);
+      DiffT **binSizes = scratch.acquire<DiffT *>(maxThreads);
+      for (int t = 0; t != maxThreads; ++t) binSizes[t] = scratch.acquire<DiffT>(binCount);
+      DiffT *binGlobalSizes = scratch.acquire<DiffT>(binCount);
+      DiffT *binOffsets = scratch.acquire<DiffT>(binCount);
 
       /// double buffer strategy
       std::vector<KeyT> keyBuffers[2];
@@ -584,14 +644,13 @@ namespace zs {
         }
 
         /// init
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads) \
     shared(skip, nths, nwork, binSizes, binGlobalSizes, binOffsets, cur, next, curVals, nextVals)
         {
 #pragma omp single
           {
             nths = omp_get_num_threads();
             nwork = (dist + nths - 1) / nths;
-            binSizes.resize(nths);
             skip = false;
           }
 #pragma omp barrier
@@ -600,9 +659,6 @@ namespace zs {
           DiffT l = nwork * tid;
           DiffT r = l + nwork;
           if (r > dist) r = dist;
-          /// init
-          binSizes[tid].resize(binCount);
-
           /// local count
           for (DiffT i = 0; i < binCount; ++i) binSizes[tid][i] = 0;
           if (l < dist)
@@ -684,21 +740,610 @@ namespace zs {
           FWD(valsIn), FWD(keysOut), FWD(valsOut), count, sbit, ebit, loc);
     }
 
+    /// comparison sorts (in place) for keys radix sort cannot handle, see merge_sort_impl
+    template <class RandomIt,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+    void sort(RandomIt &&first, RandomIt &&last, Compare &&comp = {},
+              const source_location &loc = source_location::current()) const {
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      merge_sort_impl(first, last - first, comp, false);
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+    }
+    template <class RandomIt,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<RandomIt>>::value_type>>
+    void stable_sort(RandomIt &&first, RandomIt &&last, Compare &&comp = {},
+                     const source_location &loc = source_location::current()) const {
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      merge_sort_impl(first, last - first, comp, true);
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+    }
+    /// stable sort of [keysFirst, keysLast) by comp, the values are permuted along with the keys
+    template <class KeyIter, class ValueIter,
+              class Compare
+              = std::less<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    void sort_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                     Compare &&comp = {},
+                     const source_location &loc = source_location::current()) const {
+      using KeyT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type;
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type;
+      using DiffT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::difference_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      const DiffT dist = keysLast - keysFirst;
+      std::vector<std::pair<KeyT, ValueT>> pairs(dist);
+#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+      for (DiffT i = 0; i < dist; ++i) {
+        pairs[i].first = *(keysFirst + i);
+        pairs[i].second = *(valsFirst + i);
+      }
+      auto keyComp = [&comp](const auto &a, const auto &b) { return comp(a.first, b.first); };
+      merge_sort_impl(pairs.begin(), dist, keyComp, true);
+#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+      for (DiffT i = 0; i < dist; ++i) {
+        *(keysFirst + i) = pairs[i].first;
+        *(valsFirst + i) = pairs[i].second;
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+    }
+
+    /// stream compaction, all stable and returning the number of selected elements directly.
+    /// each is a single team launch evaluating pred once per element, see compact_impl
+    /// copies the elements satisfying pred to d_first
+    template <class InputIt, class OutputIt, class Predicate>
+    auto copy_if(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred,
+                 const source_location &loc = source_location::current()) const {
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      const auto numSelected = compact_impl(
+          last - first, [&](auto i) { return pred(*(first + i)); },
+          [&](auto i, bool selected, auto rank) {
+            if (selected) *(d_first + rank) = *(first + i);
+          },
+          [](auto, auto, auto) {});
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numSelected;
+    }
+    /// moves the elements not satisfying pred to the front, the rest is left unspecified
+    template <class ForwardIt, class Predicate>
+    auto remove_if(ForwardIt &&first, ForwardIt &&last, Predicate &&pred,
+                   const source_location &loc = source_location::current()) const {
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      std::vector<ValueT> buffer(last - first);
+      const auto numKept = compact_impl(
+          last - first, [&](auto i) { return !pred(*(first + i)); },
+          [&](auto i, bool kept, auto rank) {
+            if (kept) buffer[rank] = std::move(*(first + i));
+          },
+          [&](auto st, auto ed, auto numKept) {
+            if (ed > numKept) ed = numKept;
+            for (auto i = st; i < ed; ++i) *(first + i) = std::move(buffer[i]);
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numKept;
+    }
+    /// reorders the elements satisfying pred before the others (preserving the relative order
+    /// within either group), returns the size of the first group
+    template <class ForwardIt, class Predicate>
+    auto partition(ForwardIt &&first, ForwardIt &&last, Predicate &&pred,
+                   const source_location &loc = source_location::current()) const {
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      std::vector<ValueT> buffer(last - first);
+      const auto numSelected = compact_impl(
+          last - first, [&](auto i) { return pred(*(first + i)); },
+          [&](auto i, bool, auto rank) { buffer[rank] = std::move(*(first + i)); },
+          [&](auto st, auto ed, auto) {
+            for (auto i = st; i < ed; ++i) *(first + i) = std::move(buffer[i]);
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numSelected;
+    }
+
+    /// segment-wise primitives over consecutive runs of equal keys (as judged by pred), which
+    /// usually follow a sort. all return the number of runs
+    /// keeps the first element of every run at the front
+    template <class ForwardIt,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type>>
+    auto unique(ForwardIt &&first, ForwardIt &&last, BinaryPredicate &&pred = {},
+                const source_location &loc = source_location::current()) const {
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ForwardIt>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      std::vector<ValueT> buffer(last - first);
+      const auto numRuns = compact_impl(
+          last - first,
+          [&](auto i) { return i == 0 || !pred(*(first + (i - 1)), *(first + i)); },
+          [&](auto i, bool head, auto rank) {
+            if (head) buffer[rank] = *(first + i);
+          },
+          [&](auto st, auto ed, auto numRuns) {
+            if (ed > numRuns) ed = numRuns;
+            for (auto i = st; i < ed; ++i) *(first + i) = std::move(buffer[i]);
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numRuns;
+    }
+    /// keeps the first key of every run along with its value at the front
+    template <class KeyIter, class ValueIter,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    auto unique_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                       BinaryPredicate &&pred = {},
+                       const source_location &loc = source_location::current()) const {
+      using KeyT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type;
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      std::vector<KeyT> keyBuffer(keysLast - keysFirst);
+      std::vector<ValueT> valBuffer(keysLast - keysFirst);
+      const auto numRuns = compact_impl(
+          keysLast - keysFirst,
+          [&](auto i) { return i == 0 || !pred(*(keysFirst + (i - 1)), *(keysFirst + i)); },
+          [&](auto i, bool head, auto rank) {
+            if (head) {
+              keyBuffer[rank] = *(keysFirst + i);
+              valBuffer[rank] = std::move(*(valsFirst + i));
+            }
+          },
+          [&](auto st, auto ed, auto numRuns) {
+            if (ed > numRuns) ed = numRuns;
+            for (auto i = st; i < ed; ++i) {
+              *(keysFirst + i) = std::move(keyBuffer[i]);
+              *(valsFirst + i) = std::move(valBuffer[i]);
+            }
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numRuns;
+    }
+    /// writes the key of every run and the op-fold (left to right) of its values to the outputs,
+    /// the result is deterministic regardless of the team size
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>,
+              class BinaryOp
+              = std::plus<typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type>>
+    auto reduce_by_key(KeyIter &&keysFirst, KeyIter &&keysLast, ValueIter &&valsFirst,
+                       KeyOutIter &&keysOut, ValueOutIter &&valsOut, BinaryPredicate &&pred = {},
+                       BinaryOp &&op = {},
+                       const source_location &loc = source_location::current()) const {
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      const auto numRuns = segmented_reduce_impl(
+          keysLast - keysFirst,
+          [&](auto i) { return !pred(*(keysFirst + (i - 1)), *(keysFirst + i)); },
+          [&](auto i) { return *(valsFirst + i); }, op,
+          [&](auto rank, auto head, auto &&val) {
+            *(keysOut + rank) = *(keysFirst + head);
+            *(valsOut + rank) = FWD(val);
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numRuns;
+    }
+    /// writes the value and the length of every run to the outputs
+    template <class InputIt, class OutputIt, class CountIt,
+              class BinaryPredicate
+              = std::equal_to<typename std::iterator_traits<remove_cvref_t<InputIt>>::value_type>>
+    auto run_length_encode(InputIt &&first, InputIt &&last, OutputIt &&uniqueOut,
+                           CountIt &&countsOut, BinaryPredicate &&pred = {},
+                           const source_location &loc = source_location::current()) const {
+      using CountT = typename std::iterator_traits<remove_cvref_t<CountIt>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      std::plus<CountT> op{};
+      const auto numRuns = segmented_reduce_impl(
+          last - first, [&](auto i) { return !pred(*(first + (i - 1)), *(first + i)); },
+          [](auto) { return (CountT)1; }, op,
+          [&](auto rank, auto head, CountT cnt) {
+            *(uniqueOut + rank) = *(first + head);
+            *(countsOut + rank) = cnt;
+          });
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+      return numRuns;
+    }
+
+    /// host bulk transfers, split into cache-line multiple shares following the same static
+    /// partition as range(n) loops over the buffer (which thus also decides the numa placement of
+    /// freshly mapped first-touch pages). transfers beyond host_streaming_threshold_bytes use
+    /// streaming stores, small ones stay on the calling thread
+    void memcpy(void *dst, const void *src, std::size_t bytes,
+                const source_location &loc = source_location::current()) const {
+      const bool streaming = bytes >= host_streaming_threshold_bytes;
+      transfer_shares(
+          bytes,
+          [dst, src, streaming](std::size_t offset, std::size_t cnt) {
+            if (streaming)
+              copy_streaming(mem_host, (char *)dst + offset, (const char *)src + offset, cnt);
+            else
+              std::memcpy((char *)dst + offset, (const char *)src + offset, cnt);
+          },
+          loc);
+    }
+    void memset(void *dst, int ch, std::size_t bytes,
+                const source_location &loc = source_location::current()) const {
+      const bool streaming = bytes >= host_streaming_threshold_bytes;
+      transfer_shares(
+          bytes,
+          [dst, ch, streaming](std::size_t offset, std::size_t cnt) {
+            if (streaming)
+              memset_streaming(mem_host, (char *)dst + offset, ch, cnt);
+            else
+              std::memset((char *)dst + offset, ch, cnt);
+          },
+          loc);
+    }
+    /// kept from the numa placement api, same as memset(ptr, ch, bytes), whose shares are also
+    /// the first touch of freshly mapped pages
+    void first_touch(void *ptr, std::size_t bytes, int ch = 0,
+                     const source_location &loc = source_location::current()) const {
+      memset(ptr, ch, bytes, loc);
+    }
+
     OmpExecutionPolicy &threads(int numThreads) noexcept {
       _dop = numThreads;
       return *this;
     }
+    /// how ranges without random access (forward iterators, openvdb iterators, exec<I>) are
+    /// spread: 0 spawns one task per element, otherwise consecutive runs of grain elements are
+    /// scheduled by work stealing (see steal_chunks)
+    OmpExecutionPolicy &stealing(std::size_t grain) noexcept {
+      _stealGrain = grain;
+      return *this;
+    }
+    /// loop schedule of the random access ranges and Collapse loops, defaults to the even static
+    /// split. dynamic or guided (with chunk iterations per grab, 0 for the omp default) suit
+    /// kernels whose per-iteration cost varies wildly, e.g. particle-per-block transfers
+    OmpExecutionPolicy &schedule(omp_sched_t kind, int chunk = 0) noexcept {
+      _schedule = kind;
+      _chunk = chunk;
+      return *this;
+    }
 
   protected:
+    /// installs the runtime schedule read by the schedule(runtime) loops within its scope
+    struct scoped_schedule {
+      scoped_schedule(omp_sched_t kind, int chunk) {
+        omp_get_schedule(&_prevKind, &_prevChunk);
+        omp_set_schedule(kind, chunk);
+      }
+      ~scoped_schedule() { omp_set_schedule(_prevKind, _prevChunk); }
+      omp_sched_t _prevKind;
+      int _prevChunk;
+    };
+
+    /// each thread sorts one contiguous block, then ceil(log2(nths)) rounds merge pairs of
+    /// sorted runs back and forth with a buffer. within a round every thread writes an equal
+    /// slice of the output (see merge_slice), so the later rounds with few but long runs still
+    /// keep the whole team busy. the merges are stable, hence so is the result when the blocks
+    /// are stable sorted
+    template <typename RandomIt, typename DiffT, typename Compare>
+    void merge_sort_impl(RandomIt first, DiffT dist, Compare &comp, bool stable) const {
+      using ValueT = typename std::iterator_traits<RandomIt>::value_type;
+      /// smaller blocks are not worth a thread
+      constexpr DiffT minBlockSize = 2048;
+      const int maxThreads
+          = (int)std::min((DiffT)std::max(_dop, 1), std::max((DiffT)1, dist / minBlockSize));
+      if (maxThreads == 1) {
+        if (stable)
+          std::stable_sort(first, first + dist, comp);
+        else
+          std::sort(first, first + dist, comp);
+        return;
+      }
+      std::vector<ValueT> buffer(dist);
+      std::vector<DiffT> bounds(maxThreads + 1);
+      int nths{};
+#pragma omp parallel num_threads(maxThreads)
+      {
+#pragma omp single
+        {
+          nths = omp_get_num_threads();
+          for (int t = 0; t <= nths; ++t) bounds[t] = dist * t / nths;
+        }
+        const int tid = omp_get_thread_num();
+        if (stable)
+          std::stable_sort(first + bounds[tid], first + bounds[tid + 1], comp);
+        else
+          std::sort(first + bounds[tid], first + bounds[tid + 1], comp);
+        int round = 0;
+        for (int width = 1; width < nths; width *= 2, ++round) {
+#pragma omp barrier
+          if (round % 2 == 0)
+            merge_slice(first, buffer.begin(), bounds.data(), nths, width, tid, comp);
+          else
+            merge_slice(buffer.begin(), first, bounds.data(), nths, width, tid, comp);
+        }
+        /// the last round wrote into the buffer while still reading from the range
+        if (round % 2 == 1) {
+#pragma omp barrier
+          std::copy(buffer.begin() + bounds[tid], buffer.begin() + bounds[tid + 1],
+                    first + bounds[tid]);
+        }
+      }
+    }
+    /// output slice [bounds[tid], bounds[tid + 1]) of the round merging runs of width blocks
+    /// pairwise. its inputs from either run are located by a binary search along the merge path
+    template <typename SrcIt, typename DstIt, typename DiffT, typename Compare>
+    static void merge_slice(SrcIt src, DstIt dst, const DiffT *bounds, int nths, int width,
+                            int tid, Compare &comp) {
+      const int lo = tid / (2 * width) * (2 * width);
+      const int mid = std::min(lo + width, nths), hi = std::min(lo + 2 * width, nths);
+      const SrcIt a = src + bounds[lo], b = src + bounds[mid];
+      const DiffT m = bounds[mid] - bounds[lo], n = bounds[hi] - bounds[mid];
+      /// number of elements from run a among the first k merged ones, ties favor a
+      auto corank = [&](DiffT k) {
+        DiffT l = k > n ? k - n : 0, r = k < m ? k : m;
+        while (l < r) {
+          const DiffT i = (l + r) / 2;
+          if (!comp(*(b + (k - i - 1)), *(a + i)))
+            l = i + 1;
+          else
+            r = i;
+        }
+        return l;
+      };
+      const DiffT k0 = bounds[tid] - bounds[lo], k1 = bounds[tid + 1] - bounds[lo];
+      DiffT i = corank(k0), j = k0 - i;
+      const DiffT ie = corank(k1), je = k1 - ie;
+      DstIt out = dst + bounds[tid];
+      DiffT o = 0;
+      while (i < ie && j < je) {
+        if (comp(*(b + j), *(a + i)))
+          *(out + o++) = *(b + j++);
+        else
+          *(out + o++) = *(a + i++);
+      }
+      for (; i < ie; ++i) *(out + o++) = *(a + i);
+      for (; j < je; ++j) *(out + o++) = *(b + j);
+    }
+
+    /// every thread evaluates flagOf(i) once per index of its block and counts the hits, then
+    /// (after a barrier) hands each element of its block to
+    ///   scatter(i, flag, rank)
+    /// where rank is its stable position among the selected ones, or numSelected plus its
+    /// position among the rest. after another barrier finish(st, ed, numSelected) runs on the
+    /// same block, for writing results staged in a buffer back in place
+    template <typename DiffT, typename FlagF, typename ScatterF, typename FinishF>
+    DiffT compact_impl(DiffT dist, FlagF &&flagOf, ScatterF &&scatter, FinishF &&finish) const {
+      std::vector<unsigned char> flags(dist);
+      /// the team is capped at maxThreads (a non-positive _dop would follow OMP_NUM_THREADS)
+      const int maxThreads = std::max(_dop, 1);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      DiffT *counts = scratch.acquire<DiffT>(maxThreads);
+      DiffT nths{}, numSelected{};
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads)
+      {
+#pragma omp single
+        { nths = omp_get_num_threads(); }
+        const DiffT tid = omp_get_thread_num();
+        const DiffT nwork = (dist + nths - 1) / nths;
+        const DiffT st = std::min(nwork * tid, dist), ed = std::min(st + nwork, dist);
+        DiffT cnt = 0;
+        for (DiffT i = st; i < ed; ++i) cnt += (flags[i] = flagOf(i) ? 1 : 0);
+        counts[tid] = cnt;
+#pragma omp barrier
+        DiffT selectedRank = 0, total = 0;
+        for (DiffT t = 0; t < nths; ++t) {
+          if (t == tid) selectedRank = total;
+          total += counts[t];
+        }
+        if (tid == 0) numSelected = total;
+        DiffT restRank = total + st - selectedRank;
+        for (DiffT i = st; i < ed; ++i) {
+          if (flags[i])
+            scatter(i, true, selectedRank++);
+          else
+            scatter(i, false, restRank++);
+        }
+#pragma omp barrier
+        finish(st, ed, total);
+      }
+      return numSelected;
+    }
+    /// segments start at index 0 and at every i where isHead(i) holds. every thread flags the
+    /// heads within its block and folds the leading elements that continue a segment begun in
+    /// an earlier block into a carry. after a barrier each segment is folded (left to right) by
+    /// the thread owning its head, which appends the carries of the blocks the segment runs on
+    /// into, then passed to emit(rank, headIndex, value)
+    template <typename DiffT, typename HeadF, typename ValueF, typename BinaryOp, typename EmitF>
+    DiffT segmented_reduce_impl(DiffT dist, HeadF &&isHead, ValueF &&valueOf, BinaryOp &op,
+                                EmitF &&emit) const {
+      using ValueT = remove_cvref_t<decltype(valueOf(dist))>;
+      std::vector<unsigned char> flags(dist);
+      /// the team is capped at maxThreads (a non-positive _dop would follow OMP_NUM_THREADS)
+      const int maxThreads = std::max(_dop, 1);
+      std::vector<ValueT> carries(maxThreads);
+      std::vector<unsigned char> hasCarry(maxThreads);
+      scratch_arena::scope scratch{scratch_arena::thread_local_instance()};
+      DiffT *counts = scratch.acquire<DiffT>(maxThreads);
+      DiffT nths{}, numSegments{};
+#pragma omp parallel if (maxThreads < dist) num_threads(maxThreads)
+      {
+#pragma omp single
+        { nths = omp_get_num_threads(); }
+        const DiffT tid = omp_get_thread_num();
+        const DiffT nwork = (dist + nths - 1) / nths;
+        const DiffT st = std::min(nwork * tid, dist), ed = std::min(st + nwork, dist);
+        DiffT cnt = 0;
+        for (DiffT i = st; i < ed; ++i) cnt += (flags[i] = (i == 0 || isHead(i)) ? 1 : 0);
+        counts[tid] = cnt;
+        hasCarry[tid] = st < ed && !flags[st];
+        if (hasCarry[tid]) {
+          ValueT carry = valueOf(st);
+          for (DiffT i = st + 1; i < ed && !flags[i]; ++i) carry = op(carry, valueOf(i));
+          carries[tid] = carry;
+        }
+#pragma omp barrier
+        DiffT rank = 0, total = 0;
+        for (DiffT t = 0; t < nths; ++t) {
+          if (t == tid) rank = total;
+          total += counts[t];
+        }
+        if (tid == 0) numSegments = total;
+        DiffT head = -1;
+        ValueT acc{};
+        for (DiffT i = st; i < ed; ++i) {
+          if (flags[i]) {
+            if (head >= 0) emit(rank++, head, std::move(acc));
+            head = i;
+            acc = valueOf(i);
+          } else if (head >= 0)
+            acc = op(acc, valueOf(i));
+        }
+        if (head >= 0) {
+          for (DiffT t = tid + 1; t < nths && hasCarry[t]; ++t) {
+            acc = op(acc, carries[t]);
+            if (counts[t]) break;
+          }
+          emit(rank, head, std::move(acc));
+        }
+      }
+      return numSegments;
+    }
+
+    /// walks [first, !valid) once on the calling thread to record the head of every chunk of
+    /// _stealGrain elements, then each thread works from the front of its static share of the
+    /// chunks and, once it runs dry, steals the back half of another thread's remaining share
+    template <typename Iter, typename ValidF, typename AdvanceF, typename BodyF>
+    void steal_chunks(Iter first, ValidF &&valid, AdvanceF &&advance, BodyF &&body) const {
+      std::vector<Iter> heads{};
+      std::size_t n = 0;
+      for (Iter it = first; valid(it); advance(it), ++n)
+        if (n % _stealGrain == 0) heads.push_back(it);
+      const std::size_t numChunks = heads.size();
+      if (numChunks == 0) return;
+
+      struct alignas(64) share_t {
+        std::mutex mutex{};
+        std::size_t st{0}, ed{0};
+      };
+      const int maxThreads = std::max(_dop, 1);
+      std::vector<share_t> shares(maxThreads);
+      auto runChunk = [&](std::size_t chunkNo) {
+        Iter it = heads[chunkNo];
+        const std::size_t cnt
+            = chunkNo + 1 == numChunks ? n - chunkNo * _stealGrain : _stealGrain;
+        for (std::size_t k = 0; k != cnt; ++k, advance(it)) body(it);
+      };
+#pragma omp parallel if (maxThreads > 1 && numChunks > 1) num_threads(maxThreads)
+      {
+        const std::size_t nths = omp_get_num_threads(), tid = omp_get_thread_num();
+        auto &mine = shares[tid];
+        {
+          const std::size_t q = numChunks / nths, r = numChunks % nths;
+          std::lock_guard<std::mutex> lk{mine.mutex};
+          mine.st = tid * q + std::min(tid, r);
+          mine.ed = mine.st + q + (tid < r ? 1 : 0);
+        }
+#pragma omp barrier
+        for (;;) {
+          std::size_t chunkNo = numChunks;
+          {
+            std::lock_guard<std::mutex> lk{mine.mutex};
+            if (mine.st < mine.ed) chunkNo = mine.st++;
+          }
+          if (chunkNo != numChunks) {
+            runChunk(chunkNo);
+            continue;
+          }
+          /// work never grows, thus once every share is found empty the loop is done
+          bool stolen = false;
+          for (std::size_t k = 1; k != nths && !stolen; ++k) {
+            auto &victim = shares[(tid + k) % nths];
+            std::size_t st = 0, ed = 0;
+            {
+              std::lock_guard<std::mutex> lk{victim.mutex};
+              if (victim.st == victim.ed) continue;
+              /// rounds down, a lone chunk is thus taken whole
+              st = victim.st + (victim.ed - victim.st) / 2;
+              ed = victim.ed;
+              victim.ed = st;
+            }
+            std::lock_guard<std::mutex> lk{mine.mutex};
+            mine.st = st;
+            mine.ed = ed;
+            stolen = true;
+          }
+          if (!stolen) break;
+        }
+      }
+    }
+
+    template <typename F>
+    void transfer_shares(std::size_t bytes, F &&f, const source_location &loc) const {
+      if (bytes == 0) return;
+      if (_dop <= 1 || bytes < host_parallel_transfer_threshold_bytes) {
+        f((std::size_t)0, bytes);
+        return;
+      }
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      const std::size_t numLines = (bytes + 63) / 64;
+#pragma omp parallel num_threads(_dop)
+      {
+        const std::size_t nths = omp_get_num_threads(), tid = omp_get_thread_num();
+        const std::size_t q = numLines / nths, r = numLines % nths;
+        const std::size_t st = std::min((tid * q + std::min(tid, r)) * 64, bytes);
+        const std::size_t ed = std::min(st + (q + (tid < r ? 1 : 0)) * 64, bytes);
+        if (st < ed) f(st, ed - st);
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
+                               loc.column()));
+    }
+
     friend struct ExecutionPolicyInterface<OmpExecutionPolicy>;
 
     int _dop{1};
+    std::size_t _stealGrain{0};
+    omp_sched_t _schedule{omp_sched_static};
+    int _chunk{0};
   };
 
   constexpr bool is_backend_available(OmpExecutionPolicy) noexcept { return true; }
   constexpr bool is_backend_available(omp_exec_tag) noexcept { return true; }
 
   uint get_hardware_concurrency() noexcept;
+
+  /// how omp threads are pinned onto the cpus this process may run on
+  ///   compact: consecutive threads share a socket (then a core) before moving to the next one
+  ///   scatter: consecutive threads alternate between sockets, spreading memory bandwidth
+  enum struct omp_thread_binding_e : char { none = 0, compact, scatter };
+  /// pins the worker threads 1..numThreads-1 of the omp thread pool to one cpu each (wrapping
+  /// around when oversubscribed), whereas the calling thread (thread 0) is left unpinned. later
+  /// teams of at most numThreads threads reuse the pinned pool threads, wider ones also start
+  /// unpinned threads. a no-op when OMP_PROC_BIND already binds the threads, which is the
+  /// preferred way when the environment can be set before launch. returns false when pinning is
+  /// unsupported (non-linux) or failed. also applied once at startup when ZS_OMP_THREAD_BINDING
+  /// is "compact" or "scatter"
+  ZPC_API bool pin_omp_threads(int numThreads, omp_thread_binding_e binding);
   inline OmpExecutionPolicy omp_exec() noexcept {
     return OmpExecutionPolicy{}.threads(get_hardware_concurrency() - 1);
   }
@@ -1,7 +1,13 @@
 #include "Resource.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "zensim/Port.hpp"
-#include "zensim/execution/Concurrency.h"
 #include "zensim/memory/MemoryResource.h"
 #if ZS_ENABLE_CUDA
 #  include "zensim/cuda/Port.hpp"
@@ -12,8 +18,124 @@
 
 namespace zs {
 
-  static std::shared_mutex g_resource_rw_mutex{};
-  static concurrent_map<void *, Resource::AllocationRecord> g_resource_records;
+#if ZS_ENABLE_ALLOCATION_RECORDS
+  /// per-allocation records, sharded by pointer hash so that concurrent (de)allocations of
+  /// different buffers rarely contend on the same lock
+  struct AllocationRecordRegistry {
+    static constexpr std::size_t num_shard_bits = 6;
+    struct alignas(64) Shard {
+      std::mutex mutex{};
+      std::unordered_map<void *, Resource::AllocationRecord> records{};
+    };
+    Shard &shard(const void *ptr) noexcept {
+      /// fibonacci hashing, allocations are at least 16-byte aligned
+      return _shards[(((std::uintptr_t)ptr >> 4) * (std::uintptr_t)0x9E3779B97F4A7C15ull)
+                     >> (sizeof(std::uintptr_t) * 8 - num_shard_bits)];
+    }
+    template <typename F> void for_each(F &&f) {
+      for (auto &shard : _shards) {
+        std::lock_guard<std::mutex> lk{shard.mutex};
+        for (auto &&[ptr, record] : shard.records) f(ptr, record);
+      }
+    }
+    void clear() {
+      for (auto &shard : _shards) {
+        std::lock_guard<std::mutex> lk{shard.mutex};
+        shard.records.clear();
+      }
+    }
+    std::array<Shard, (std::size_t)1 << num_shard_bits> _shards{};
+  };
+  static AllocationRecordRegistry g_resource_records{};
+#endif
+
+  /// allocation telemetry counters, kept even when records are compiled out
+  /// they outlive g_resource (whose destruction disables telemetry)
+  static std::atomic<bool> g_telemetry_enabled{false};
+  /// cleared once g_resource is constructed
+  static std::atomic<bool> g_telemetry_at_startup{true};
+  struct AtomicAllocationStats {
+    std::atomic<std::size_t> liveBytes{0}, peakBytes{0}, liveCount{0}, totalCount{0};
+
+    void allocate(std::size_t size) noexcept {
+      const auto live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+      liveCount.fetch_add(1, std::memory_order_relaxed);
+      totalCount.fetch_add(1, std::memory_order_relaxed);
+      auto peak = peakBytes.load(std::memory_order_relaxed);
+      while (live > peak
+             && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+    }
+    void deallocate(std::size_t size) noexcept {
+      liveBytes.fetch_sub(size, std::memory_order_relaxed);
+      liveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    Resource::AllocationStats snapshot() const noexcept {
+      return Resource::AllocationStats{liveBytes.load(), peakBytes.load(), liveCount.load(),
+                                       totalCount.load()};
+    }
+    void reset() noexcept {
+      liveBytes = 0;
+      peakBytes = 0;
+      liveCount = 0;
+      totalCount = 0;
+    }
+  };
+  /// categories are few and long-lived, thus lookups mostly take the shared lock. entries are
+  /// never erased since (de)allocating threads keep using the references handed out
+  struct AllocationStatsTable {
+    AtomicAllocationStats &operator[](std::string_view name) {
+      {
+        std::shared_lock<std::shared_mutex> lk{_rw};
+        if (auto it = _entries.find(name); it != _entries.end()) return *it->second;
+      }
+      std::unique_lock<std::shared_mutex> lk{_rw};
+      auto &entry = _entries[std::string(name)];
+      if (!entry) entry = std::make_unique<AtomicAllocationStats>();
+      return *entry;
+    }
+    std::map<std::string, Resource::AllocationStats> snapshot() const {
+      std::map<std::string, Resource::AllocationStats> ret{};
+      std::shared_lock<std::shared_mutex> lk{_rw};
+      for (auto &&[name, stats] : _entries)
+        if (stats->totalCount.load()) ret.emplace(name, stats->snapshot());
+      return ret;
+    }
+    void reset() {
+      std::shared_lock<std::shared_mutex> lk{_rw};
+      for (auto &&[name, stats] : _entries) stats->reset();
+    }
+
+    mutable std::shared_mutex _rw{};
+    std::map<std::string, std::unique_ptr<AtomicAllocationStats>, std::less<>> _entries{};
+  };
+  struct AllocationTelemetryStates {
+    AtomicAllocationStats total{};
+    AllocationStatsTable byTag{}, byAllocator{}, bySite{};
+    std::array<std::atomic<std::size_t>, 64> sizeHistogram{};
+  };
+  static AllocationTelemetryStates g_telemetry{};
+  static thread_local const AllocationSite *t_allocation_site{nullptr};
+
+  static std::string_view memory_tag_name(const mem_tags &tag) {
+    return match([](auto &tag) { return get_memory_tag_name(tag); })(tag);
+  }
+  static void account_allocation(mem_tags tag, std::string_view allocator, std::string_view site,
+                                 std::size_t size) {
+    g_telemetry.total.allocate(size);
+    g_telemetry.byTag[memory_tag_name(tag)].allocate(size);
+    g_telemetry.byAllocator[allocator].allocate(size);
+    if (!site.empty()) g_telemetry.bySite[site].allocate(size);
+    g_telemetry.sizeHistogram[size ? bit_length(size) - 1 : 0].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  static void account_deallocation(mem_tags tag, std::string_view allocator,
+                                   std::string_view site, std::size_t size) {
+    g_telemetry.total.deallocate(size);
+    g_telemetry.byTag[memory_tag_name(tag)].deallocate(size);
+    g_telemetry.byAllocator[allocator].deallocate(size);
+    if (!site.empty()) g_telemetry.bySite[site].deallocate(size);
+  }
 
 #if 1
   static Resource g_resource;
@@ -27,6 +149,8 @@ namespace zs {
   std::atomic_ullong &Resource::counter() noexcept { return instance()._counter; }
 
   Resource::Resource() {
+    /// ahead of the backends, whose allocations would otherwise go uncounted
+    if (std::getenv("ZS_ALLOCATION_TELEMETRY")) enable_telemetry();
     initialize_backend(exec_seq);
 #if ZS_ENABLE_CUDA
     puts("cuda initialized");
@@ -37,15 +161,18 @@ namespace zs {
     initialize_backend(exec_omp);
 #endif
     // sycl...
+    g_telemetry_at_startup = false;
   }
   Resource::~Resource() {
-    for (auto &&record : g_resource_records) {
-      const auto &[ptr, info] = record;
+    /// deallocations past this point would otherwise touch destroyed records
+    g_telemetry_enabled = false;
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    g_resource_records.for_each([](void *ptr, const AllocationRecord &info) {
       fmt::print("recycling allocation [{}], tag [{}], size [{}], alignment [{}], allocator [{}]\n",
-                 (std::uintptr_t)ptr,
-                 match([](auto &tag) { return get_memory_tag_name(tag); })(info.tag), info.size,
-                 info.alignment, info.allocatorType);
-    }
+                 (std::uintptr_t)ptr, memory_tag_name(info.tag), info.size, info.alignment,
+                 info.allocatorType);
+    });
+#endif
 #if 0
 #  if ZS_ENABLE_CUDA
     deinitialize_backend(exec_cuda);
@@ -56,21 +183,155 @@ namespace zs {
     deinitialize_backend(exec_seq);
 #endif
   }
-  void Resource::record(mem_tags tag, void *ptr, std::string_view name, std::size_t size,
-                        std::size_t alignment) {
-    g_resource_records.set(ptr, AllocationRecord{tag, size, alignment, std::string(name)});
+  void Resource::record(mem_tags tag, [[maybe_unused]] void *ptr, std::string_view name,
+                        std::size_t size, [[maybe_unused]] std::size_t alignment) {
+    std::string site{};
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    /// the deallocation side learns the site from the record
+    if (auto s = AllocationSite::current(); s)
+      site = fmt::format("{}:{} {}", s->_loc.file_name(), s->_loc.line(),
+                         s->_loc.function_name());
+#endif
+    account_allocation(tag, name, site, size);
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    auto &shard = g_resource_records.shard(ptr);
+    std::lock_guard<std::mutex> lk{shard.mutex};
+    shard.records.insert_or_assign(
+        ptr, AllocationRecord{tag, size, alignment, std::string(name), std::move(site)});
+#endif
+  }
+  void Resource::erase([[maybe_unused]] void *ptr) {
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    AllocationRecord record{};
+    {
+      auto &shard = g_resource_records.shard(ptr);
+      std::lock_guard<std::mutex> lk{shard.mutex};
+      auto it = shard.records.find(ptr);
+      if (it == shard.records.end()) return;
+      record = std::move(it->second);
+      shard.records.erase(it);
+    }
+    account_deallocation(record.tag, record.allocatorType, record.site, record.size);
+#endif
   }
-  void Resource::erase(void *ptr) { g_resource_records.erase(ptr); }
 
-  void Resource::deallocate(void *ptr) {
-    if (g_resource_records.find(ptr) != nullptr) {
-      std::unique_lock lk(g_resource_rw_mutex);
-      const auto &r = g_resource_records.get(ptr);
-      match([&r, ptr](auto &tag) { zs::deallocate(tag, ptr, r.size, r.alignment); })(r.tag);
-    } else
+  void Resource::enable_telemetry(bool enable) {
+#if !ZS_ENABLE_ALLOCATION_RECORDS
+    /// without records a free cannot tell whether its allocation was counted, thus counting has
+    /// to start before anything is allocated
+    if (enable && !g_telemetry_enabled && !g_telemetry_at_startup)
       throw std::runtime_error(
-          fmt::format("allocation record {} not found in records!", (std::uintptr_t)ptr));
-    g_resource_records.erase(ptr);
+          "allocation telemetry can only be enabled at startup (ZS_ALLOCATION_TELEMETRY) when "
+          "allocation records are compiled out (ZS_ENABLE_ALLOCATION_RECORDS)");
+#endif
+    g_telemetry_enabled = enable;
+    if (!enable) {
+#if ZS_ENABLE_ALLOCATION_RECORDS
+      g_resource_records.clear();
+#endif
+      g_telemetry.total.reset();
+      g_telemetry.byTag.reset();
+      g_telemetry.byAllocator.reset();
+      g_telemetry.bySite.reset();
+      for (auto &cnt : g_telemetry.sizeHistogram) cnt = 0;
+    }
+  }
+  bool Resource::telemetry_enabled() noexcept { return g_telemetry_enabled.load(); }
+
+  Resource::Telemetry Resource::telemetry([[maybe_unused]] std::size_t topN) {
+    Telemetry ret{};
+    ret.total = g_telemetry.total.snapshot();
+    ret.byTag = g_telemetry.byTag.snapshot();
+    ret.byAllocator = g_telemetry.byAllocator.snapshot();
+    ret.bySite = g_telemetry.bySite.snapshot();
+    for (std::size_t i = 0; i != ret.sizeHistogram.size(); ++i)
+      ret.sizeHistogram[i] = g_telemetry.sizeHistogram[i].load();
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    if (topN)
+      g_resource_records.for_each([&ret, topN](void *ptr, const AllocationRecord &record) {
+        if (ret.largest.size() == topN && ret.largest.back().second.size >= record.size) return;
+        auto it = std::upper_bound(
+            ret.largest.begin(), ret.largest.end(), record.size,
+            [](std::size_t size, const auto &entry) { return size > entry.second.size; });
+        ret.largest.emplace(it, ptr, record);
+        if (ret.largest.size() > topN) ret.largest.pop_back();
+      });
+#endif
+    return ret;
+  }
+
+  void Resource::print_telemetry(std::size_t topN) {
+    const auto t = telemetry(topN);
+    auto printStats = [](std::string_view name, const AllocationStats &stats) {
+      fmt::print("  {:<48} live {:>14} bytes ({:>8} allocs), peak {:>14} bytes, {:>10} total\n",
+                 name, stats.liveBytes, stats.liveCount, stats.peakBytes, stats.totalCount);
+    };
+    fmt::print("allocation telemetry\n");
+    printStats("total", t.total);
+    fmt::print(" by memory tag\n");
+    for (auto &&[name, stats] : t.byTag) printStats(name, stats);
+    fmt::print(" by allocator\n");
+    for (auto &&[name, stats] : t.byAllocator) printStats(name, stats);
+    if (!t.bySite.empty()) {
+      fmt::print(" by call site\n");
+      for (auto &&[name, stats] : t.bySite) printStats(name, stats);
+    }
+    fmt::print(" size histogram\n");
+    for (std::size_t i = 0; i != t.sizeHistogram.size(); ++i)
+      if (t.sizeHistogram[i])
+        fmt::print("  [2^{:<2}, 2^{:<2}) {:>10}\n", i, i + 1, t.sizeHistogram[i]);
+    fmt::print(" largest live allocations\n");
+    for (auto &&[ptr, record] : t.largest)
+      fmt::print("  [{}] {} bytes, tag [{}], allocator [{}] {}\n", (std::uintptr_t)ptr,
+                 record.size,
+                 match([](auto &tag) { return get_memory_tag_name(tag); })(record.tag),
+                 record.allocatorType, record.site);
+  }
+
+  AllocationSite::AllocationSite(const source_location &loc)
+      : _loc{loc}, _prev{t_allocation_site} {
+    t_allocation_site = this;
+  }
+  AllocationSite::~AllocationSite() { t_allocation_site = _prev; }
+  const AllocationSite *AllocationSite::current() noexcept { return t_allocation_site; }
+
+  bool allocation_telemetry_enabled() noexcept {
+    return g_telemetry_enabled.load(std::memory_order_relaxed);
+  }
+  void record_allocation(mem_tags tag, void *ptr, std::string_view allocator, std::size_t size,
+                         std::size_t alignment) {
+    Resource::instance().record(tag, ptr, allocator, size, alignment);
+  }
+  void erase_allocation([[maybe_unused]] mem_tags tag, [[maybe_unused]] void *ptr,
+                        [[maybe_unused]] std::string_view allocator,
+                        [[maybe_unused]] std::size_t size) {
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    Resource::instance().erase(ptr);
+#else
+    account_deallocation(tag, allocator, {}, size);
+#endif
+  }
+
+  void Resource::deallocate([[maybe_unused]] void *ptr) {
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    AllocationRecord record{};
+    {
+      auto &shard = g_resource_records.shard(ptr);
+      std::lock_guard<std::mutex> lk{shard.mutex};
+      auto it = shard.records.find(ptr);
+      if (it == shard.records.end())
+        throw std::runtime_error(
+            fmt::format("allocation record {} not found in records!", (std::uintptr_t)ptr));
+      record = std::move(it->second);
+      shard.records.erase(it);
+    }
+    account_deallocation(record.tag, record.allocatorType, record.site, record.size);
+    match([&record, ptr](auto &tag) {
+      zs::deallocate(tag, ptr, record.size, record.alignment);
+    })(record.tag);
+#else
+    throw std::runtime_error("allocation records are compiled out (ZS_ENABLE_ALLOCATION_RECORDS)");
+#endif
   }
 
 }  // namespace zs
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <map>
 #include <stdexcept>
 #include <vector>
 
@@ -19,6 +21,12 @@
 #if ZS_ENABLE_OPENMP
 #endif
 
+/// per-allocation records back the call site breakdown, the largest live allocations and
+/// Resource::deallocate. without them only the aggregate telemetry counters are kept
+#ifndef ZS_ENABLE_ALLOCATION_RECORDS
+#  define ZS_ENABLE_ALLOCATION_RECORDS 1
+#endif
+
 namespace zs {
 
   template <bool is_virtual_ = false, typename T = std::byte> struct ZPC_API ZSPmrAllocator {
@@ -194,7 +202,35 @@ namespace zs {
                                                     std::string_view advice = std::string_view{}) {
     const mem_tags tag = to_memory_source_tag(mre);
     ZSPmrAllocator<> ret{};
-    if (advice.empty()) {
+    /// size-class pooled memory, see host_memory_pool
+    if (advice == "POOL")
+      match(
+          [&ret, devid](auto tag) {
+            if constexpr (is_memory_source_available(tag) || is_same_v<RM_CVREF_T(tag), mem_tags>)
+              ret.setOwningUpstream<pooled_memory_resource>(tag, devid);
+          },
+          [](...) {})(tag);
+    /// huge pages, see huge_page_memory_resource
+    else if (advice == "HUGE_PAGE")
+      match(
+          [&ret, devid](auto tag) {
+            if constexpr (is_memory_source_available(tag) || is_same_v<RM_CVREF_T(tag), mem_tags>)
+              ret.setOwningUpstream<huge_page_memory_resource>(tag, devid);
+          },
+          [](...) {})(tag);
+    /// numa page placement, see numa_memory_resource. devid is the node for NUMA_BIND
+    else if (advice == "NUMA_FIRST_TOUCH" || advice == "NUMA_INTERLEAVE" || advice == "NUMA_BIND") {
+      const auto placement = advice == "NUMA_BIND"         ? numa_placement_e::bind
+                             : advice == "NUMA_INTERLEAVE" ? numa_placement_e::interleave
+                                                           : numa_placement_e::first_touch;
+      match(
+          [&ret, devid, placement](auto tag) {
+            if constexpr (is_memory_source_available(tag) || is_same_v<RM_CVREF_T(tag), mem_tags>)
+              ret.setOwningUpstream<numa_memory_resource>(tag, devid, placement);
+          },
+          [](...) {})(tag);
+    }
+    else if (advice.empty()) {
       if (mre == memsrc_e::um) {
         if (devid < -1)
           match(
@@ -283,10 +319,51 @@ namespace zs {
       }
     }
 
+    /// with a policy providing host memcpy/memset (e.g. OmpExecutionPolicy), host transfers are
+    /// split across its threads. otherwise the same as above
+    template <typename Policy>
+    static void copy(Policy &&policy, MemoryEntity dst, MemoryEntity src, std::size_t numBytes) {
+      constexpr auto hasHostMemcpy = is_valid(
+          [](auto t) -> decltype((void)std::declval<typename decltype(t)::type>().memcpy(
+                         std::declval<void *>(), std::declval<const void *>(), 0)) {});
+      if constexpr (hasHostMemcpy(wrapt<remove_cvref_t<Policy>>{}))
+        if (dst.location.onHost() && src.location.onHost()) {
+          policy.memcpy(dst.ptr, src.ptr, numBytes);
+          return;
+        }
+      copy(dst, src, numBytes);
+    }
+    template <typename Policy>
+    static void memset(Policy &&policy, MemoryEntity dst, char ch, std::size_t numBytes) {
+      constexpr auto hasHostMemset = is_valid(
+          [](auto t) -> decltype((void)std::declval<typename decltype(t)::type>().memset(
+                         std::declval<void *>(), 0, 0)) {});
+      if constexpr (hasHostMemset(wrapt<remove_cvref_t<Policy>>{}))
+        if (dst.location.onHost()) {
+          policy.memset(dst.ptr, ch, numBytes);
+          return;
+        }
+      memset(dst, ch, numBytes);
+    }
+
     struct AllocationRecord {
       mem_tags tag{};
       std::size_t size{0}, alignment{0};
       std::string allocatorType{};
+      /// call site from the innermost AllocationSite scope, if any
+      std::string site{};
+    };
+    struct AllocationStats {
+      std::size_t liveBytes{0}, peakBytes{0}, liveCount{0}, totalCount{0};
+    };
+    /// snapshot of the recorded allocations
+    struct Telemetry {
+      AllocationStats total{};
+      std::map<std::string, AllocationStats> byTag{}, byAllocator{}, bySite{};
+      /// allocations so far per power of two, [i] counts sizes within [2^i, 2^(i+1))
+      std::array<std::size_t, 64> sizeHistogram{};
+      /// the largest live allocations in descending order
+      std::vector<std::pair<void *, AllocationRecord>> largest{};
     };
     Resource();
     ~Resource();
@@ -295,12 +372,35 @@ namespace zs {
                 std::size_t alignment);
     void erase(void *ptr);
 
+    /// memory resources record their allocations only while telemetry is enabled (also
+    /// enabled at startup if ZS_ALLOCATION_TELEMETRY is set), disabling it drops all records and
+    /// zeroes the counters. without allocation records it cannot be (re-)enabled after startup
+    static void enable_telemetry(bool enable = true);
+    static bool telemetry_enabled() noexcept;
+    static Telemetry telemetry(std::size_t topN = 10);
+    static void print_telemetry(std::size_t topN = 10);
+
     void deallocate(void *ptr);
 
   private:
     mutable std::atomic_ullong _counter{0};
   };
 
+  /// attributes the allocations this thread makes during its lifetime to the call site in
+  /// Resource::telemetry, e.g.
+  ///   { AllocationSite site{}; Vector<float> v{n}; }
+  struct ZPC_API AllocationSite {
+    AllocationSite(const source_location &loc = source_location::current());
+    ~AllocationSite();
+    AllocationSite(const AllocationSite &) = delete;
+    AllocationSite &operator=(const AllocationSite &) = delete;
+
+    static const AllocationSite *current() noexcept;
+
+    source_location _loc;
+    const AllocationSite *_prev;
+  };
+
   inline auto select_properties(const std::vector<PropertyTag> &props,
                                 const std::vector<SmallString> &names) {
     std::vector<PropertyTag> ret(0);
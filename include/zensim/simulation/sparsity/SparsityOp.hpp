@@ -45,9 +45,9 @@ namespace zs {
 
     constexpr void operator()(typename Table::value_t entry) noexcept {
       using namespace placeholders;
-      table._table.keys[entry] = Table::key_t::uniform(Table::key_scalar_sentinel_v);
+      table._table.keys[entry] = Table::storage_key_sentinel_v;
       table._table.indices[entry] = Table::sentinel_v;  // necessary for query to terminate
-      table._table.status[entry] = -1;
+      if constexpr (!Table::packed_key_v) table._table.status[entry] = -1;
       if (entry == 0) *table._cnt = 0;
     }
 
@@ -0,0 +1,21 @@
+#pragma once
+#include <string_view>
+
+#include "zensim/zpc_tpls/fmt/core.h"
+
+/// minimal harness shared by the behavior tests, a failed check is reported and counted, and
+/// main returns report_checks() as the exit code
+inline int g_numFailedChecks = 0;
+
+inline void check(bool pass, std::string_view context, std::string_view what) {
+  if (!pass) {
+    fmt::print("[{}] {} failed\n", context, what);
+    ++g_numFailedChecks;
+  }
+}
+inline void check(bool pass, std::string_view what) { check(pass, "-", what); }
+
+inline int report_checks() {
+  if (g_numFailedChecks) fmt::print("{} checks failed\n", g_numFailedChecks);
+  return g_numFailedChecks ? 1 : 0;
+}
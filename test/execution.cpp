@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "check.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+/// every policy is checked against the std algorithms on the same input
+
+template <typename Policy> void test_scan_reduce(Policy &&pol, std::string_view name, int n) {
+  std::mt19937 rng(n);
+  std::vector<int> vals(n), out(n), ref(n);
+  for (auto &v : vals) v = (int)(rng() % 2001) - 1000;
+  std::partial_sum(vals.begin(), vals.end(), ref.begin());
+  pol.inclusive_scan(vals.begin(), vals.end(), out.begin());
+  check(out == ref, name, "inclusive_scan");
+  int sum = 0;
+  pol.reduce(vals.begin(), vals.end(), &sum);
+  check(sum == ref.back(), name, "reduce");
+  pol.reduce(vals.begin(), vals.end(), &sum, 7, std::plus<int>{});
+  check(sum == ref.back() + 7, name, "reduce with init");
+  pol.radix_sort(vals.begin(), vals.end(), out.begin());
+  ref = vals;
+  std::sort(ref.begin(), ref.end());
+  check(out == ref, name, "radix_sort");
+}
+
+/// comparison sorts, stable ones keep the order of equal keys
+template <typename Policy> void test_sort(Policy &&pol, std::string_view name, int n) {
+  using namespace zs;
+  std::mt19937 rng(n);
+  auto keyOf = [](const std::array<int, 2> &e) { return e[0]; };
+  auto less = [&keyOf](const auto &a, const auto &b) { return keyOf(a) < keyOf(b); };
+  std::vector<std::array<int, 2>> elems(n);
+  for (int i = 0; i != n; ++i) elems[i] = {(int)(rng() % 17), i};
+  auto ref = elems;
+  std::stable_sort(ref.begin(), ref.end(), less);
+
+  auto sorted = elems;
+  sort(pol, sorted.begin(), sorted.end(), less);
+  /// elements are unique as a whole, so sorting both lexicographically tells a permutation
+  bool ok = std::is_sorted(sorted.begin(), sorted.end(), less);
+  auto all = elems;
+  std::sort(all.begin(), all.end());
+  std::sort(sorted.begin(), sorted.end());
+  check(ok && sorted == all, name, "sort");
+  sorted = elems;
+  stable_sort(pol, sorted.begin(), sorted.end(), less);
+  check(sorted == ref, name, "stable_sort");
+
+  std::vector<int> keys(n), ids(n);
+  for (int i = 0; i != n; ++i) {
+    keys[i] = elems[i][0];
+    ids[i] = i;
+  }
+  sort_by_key(pol, keys.begin(), keys.end(), ids.begin());
+  ok = true;
+  for (int i = 0; i != n; ++i) ok = ok && keys[i] == ref[i][0] && ids[i] == ref[i][1];
+  check(ok, name, "sort_by_key");
+}
+
+/// stream compaction keeps the relative order of the selected elements
+template <typename Policy> void test_compaction(Policy &&pol, std::string_view name, int n) {
+  std::mt19937 rng(n);
+  std::vector<int> vals(n), out(n);
+  for (auto &v : vals) v = (int)(rng() % 2001) - 1000;
+  auto pred = [](int v) { return v % 3 == 0; };
+  std::vector<int> ref;
+  std::copy_if(vals.begin(), vals.end(), std::back_inserter(ref), pred);
+  auto numSelected = pol.copy_if(vals.begin(), vals.end(), out.begin(), pred);
+  check(numSelected == (int)ref.size() && std::equal(ref.begin(), ref.end(), out.begin()), name,
+        "copy_if");
+
+  auto parted = vals;
+  auto refParted = vals;
+  std::stable_partition(refParted.begin(), refParted.end(), pred);
+  auto numFirst = pol.partition(parted.begin(), parted.end(), pred);
+  check(numFirst == (int)ref.size() && parted == refParted, name, "partition");
+
+  auto removed = vals;
+  std::vector<int> refKept;
+  std::remove_copy_if(vals.begin(), vals.end(), std::back_inserter(refKept), pred);
+  auto numKept = pol.remove_if(removed.begin(), removed.end(), pred);
+  check(numKept == (int)refKept.size()
+            && std::equal(refKept.begin(), refKept.end(), removed.begin()),
+        name, "remove_if");
+}
+
+/// segmented primitives, where runs continue as long as adjacent keys are close
+template <typename Policy> void test_segmented(Policy &&pol, std::string_view name, int n) {
+  std::mt19937 rng(n);
+  auto near = [](int a, int b) { return std::abs(a - b) <= 1; };
+  std::vector<int> keys(n), vals(n);
+  for (int i = 0; i != n; ++i) {
+    keys[i] = i / 5 * 2 + (int)(rng() % 2);
+    vals[i] = (int)(rng() % 10);
+  }
+  std::vector<int> refKeys, refSums, refHeads;
+  for (int i = 0; i != n; ++i)
+    if (i == 0 || !near(keys[i - 1], keys[i])) {
+      refKeys.push_back(keys[i]);
+      refHeads.push_back(i);
+      refSums.push_back(vals[i]);
+    } else
+      refSums.back() += vals[i];
+
+  auto uniqueKeys = keys;
+  auto numRuns = pol.unique(uniqueKeys.begin(), uniqueKeys.end(), near);
+  check(numRuns == (int)refKeys.size()
+            && std::equal(refKeys.begin(), refKeys.end(), uniqueKeys.begin()),
+        name, "unique");
+
+  auto uniqueByKey = keys;
+  std::vector<int> ids(n);
+  std::iota(ids.begin(), ids.end(), 0);
+  numRuns = pol.unique_by_key(uniqueByKey.begin(), uniqueByKey.end(), ids.begin(), near);
+  check(numRuns == (int)refKeys.size()
+            && std::equal(refKeys.begin(), refKeys.end(), uniqueByKey.begin())
+            && std::equal(refHeads.begin(), refHeads.end(), ids.begin()),
+        name, "unique_by_key");
+
+  std::vector<int> keysOut(n), sumsOut(n);
+  numRuns = pol.reduce_by_key(keys.begin(), keys.end(), vals.begin(), keysOut.begin(),
+                              sumsOut.begin(), near);
+  check(numRuns == (int)refKeys.size()
+            && std::equal(refKeys.begin(), refKeys.end(), keysOut.begin())
+            && std::equal(refSums.begin(), refSums.end(), sumsOut.begin()),
+        name, "reduce_by_key");
+
+  std::vector<int> counts(n);
+  numRuns = pol.run_length_encode(keys.begin(), keys.end(), keysOut.begin(), counts.begin(), near);
+  bool ok = numRuns == (int)refKeys.size()
+            && std::equal(refKeys.begin(), refKeys.end(), keysOut.begin());
+  for (int r = 0; ok && r != (int)numRuns; ++r)
+    ok = counts[r] == (r + 1 == (int)numRuns ? n : refHeads[r + 1]) - refHeads[r];
+  check(ok, name, "run_length_encode");
+}
+
+#if ZS_ENABLE_OPENMP
+/// a forward range with a few costly elements up front, every element is still visited exactly
+/// once whatever the stealing grain
+static void test_stealing(int numThreads, int n) {
+  std::list<int> ids(n);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::vector<std::atomic<int>> visits(n);
+  for (std::size_t grain : {1, 7, 64}) {
+    for (auto &v : visits) v = 0;
+    zs::omp_exec().threads(numThreads).stealing(grain)(ids, [&visits, n](int i) {
+      volatile int work = 0;
+      for (int k = i < n / 8 ? 20000 : 1; k; --k) work = work + k;
+      visits[i].fetch_add(1);
+    });
+    check(std::all_of(visits.begin(), visits.end(), [](const auto &v) { return v == 1; }),
+          "omp", "work stealing over a forward range");
+  }
+}
+
+/// every schedule covers a random access range and a Collapse loop exactly once, and leaves the
+/// caller's runtime schedule as it was
+static void test_schedule(int numThreads, int n) {
+  using namespace zs;
+  std::vector<std::atomic<int>> visits(n);
+  omp_set_schedule(omp_sched_dynamic, 5);
+  for (auto [kind, chunk] : {std::pair{omp_sched_static, 0}, std::pair{omp_sched_dynamic, 3},
+                             std::pair{omp_sched_guided, 0}}) {
+    auto pol = omp_exec().threads(numThreads).schedule(kind, chunk);
+    for (auto &v : visits) v = 0;
+    pol(range(n), [&visits](int i) { visits[i].fetch_add(1); });
+    const int m = n / 7 + 1;
+    pol(Collapse{7, m}, [&visits, m, n](int i, int j) {
+      if (i * m + j < n) visits[i * m + j].fetch_add(1);
+    });
+    check(std::all_of(visits.begin(), visits.end(), [](const auto &v) { return v == 2; }),
+          "omp", "scheduled loops");
+    omp_sched_t prevKind;
+    int prevChunk;
+    omp_get_schedule(&prevKind, &prevChunk);
+    check(prevKind == omp_sched_dynamic && prevChunk == 5, "omp", "restored runtime schedule");
+  }
+}
+#endif
+
+template <typename Policy> void test_policy(Policy &&pol, std::string_view name, int n) {
+  test_scan_reduce(pol, name, n);
+  test_sort(pol, name, n);
+  test_compaction(pol, name, n);
+  test_segmented(pol, name, n);
+}
+
+int main() {
+  using namespace zs;
+  for (int n : {1, 100, 4097, 100003}) test_policy(seq_exec(), "seq", n);
+#if ZS_ENABLE_OPENMP
+  for (int n : {1, 100, 4097, 100003}) {
+    for (int numThreads : {1, 3, 8}) {
+      test_policy(omp_exec().threads(numThreads), "omp", n);
+      test_stealing(numThreads, n);
+      test_schedule(numThreads, n);
+    }
+    /// a non-positive thread count (omp_exec() on a single-cpu host) must not let the team
+    /// outgrow the per-thread scratch
+    omp_set_num_threads(8);
+    test_policy(omp_exec().threads(0), "omp(0 threads)", n);
+  }
+#endif
+  return report_checks();
+}
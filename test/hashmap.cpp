@@ -0,0 +1,84 @@
+#include <string_view>
+
+#include "check.hpp"
+#include "zensim/container/HashMap.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+template <typename MapView> struct CountKeys {
+  using key_t = typename MapView::key_t;
+  void operator()(int i) {
+    const int k = i % numKeys;
+    key_t key{};
+    for (int d = 0; d != key_t::extent; ++d) key[d] = k * (d + 1) - numKeys / 2;
+    map.atomic_update(key, [](int cnt) { return cnt + 1; });
+  }
+  MapView map;
+  int numKeys;
+};
+
+/// concurrent updates of the same key accumulate, and resizing keeps every value
+template <typename Map, typename Policy> void test_map(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Map::key_t;
+  constexpr auto space = remove_cvref_t<Policy>::exec_tag::value;
+  const int numKeys = 1000, numRepeats = 7;
+  auto key_of = [](int k) {
+    key_t key{};
+    for (int d = 0; d != key_t::extent; ++d) key[d] = k * (d + 1) - numKeys / 2;
+    return key;
+  };
+
+  Map map{(std::size_t)numKeys};
+  map.reset(pol);
+  pol(range(numKeys * numRepeats),
+      CountKeys<RM_CVREF_T(proxy<space>(map))>{proxy<space>(map), numKeys});
+  auto mv = proxy<execspace_e::host>(map);
+  bool ok = map.size() == numKeys && map.overflow_count() == 0;
+  for (int k = 0; k != numKeys; ++k) {
+    auto v = mv.find(key_of(k));
+    ok = ok && v && *v == numRepeats;
+  }
+  ok = ok && !mv.contains(key_of(numKeys));
+  check(ok, name, "HashMap atomic_update");
+
+  map.resize(pol, (std::size_t)numKeys * 8);
+  mv = proxy<execspace_e::host>(map);
+  ok = map.size() == numKeys && map.capacity() >= numKeys * 8;
+  for (int k = 0; k != numKeys; ++k) {
+    auto v = mv.find(key_of(k));
+    ok = ok && v && *v == numRepeats;
+  }
+  check(ok, name, "HashMap resize");
+
+  /// assignment overwrites, and only new keys report an insertion
+  ok = !mv.insert_or_assign(key_of(3), -3) && mv.insert_or_assign(key_of(numKeys), -1);
+  ok = ok && *mv.find(key_of(3)) == -3 && *mv.find(key_of(numKeys)) == -1
+       && map.size() == numKeys + 1;
+  check(ok, name, "HashMap insert_or_assign");
+
+  /// a full map counts the rejected insertions
+  Map small{(std::size_t)4};
+  small.reset(pol);
+  auto sv = proxy<execspace_e::host>(small);
+  for (int k = 0; k != (int)small.capacity() + 3; ++k) sv.insert_or_assign(key_of(k), k);
+  check(small.size() == small.capacity() && small.overflow_count() == 3, name,
+        "HashMap overflow");
+}
+
+template <typename Policy> void test_policy(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  test_map<HashMap<vec<i32, 2>, int>>(pol, name);
+  test_map<HashMap<vec<i32, 3>, int>>(pol, name);
+}
+
+int main() {
+  using namespace zs;
+  test_policy(seq_exec(), "seq");
+#if ZS_ENABLE_OPENMP
+  test_policy(omp_exec().threads(8), "omp");
+#endif
+  return report_checks();
+}
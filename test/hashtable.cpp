@@ -0,0 +1,265 @@
+#include <string_view>
+
+#include "check.hpp"
+#include "zensim/container/HashTable.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+template <typename TableView, typename KeyView> struct InsertRepeatedKeys {
+  void operator()(int i) { tv.insert(keys[i % n]); }
+  TableView tv;
+  KeyView keys;
+  int n;
+};
+
+/// every key is inserted by several threads at once, each lands exactly once
+template <typename Table, typename Policy>
+void test_concurrent_insert(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  constexpr auto space = remove_cvref_t<Policy>::exec_tag::value;
+  const int n = 5000, numRepeats = 4;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i)
+    for (int d = 0; d != Table::dim; ++d) keys[i][d] = (i - n / 2) * (d + 1);
+
+  Table table{(std::size_t)n};
+  table.reset(pol, true);
+  pol(range(n * numRepeats),
+      InsertRepeatedKeys<RM_CVREF_T(proxy<space>(table)), RM_CVREF_T(proxy<space>(keys))>{
+          proxy<space>(table), proxy<space>(keys), n});
+  auto tv = proxy<execspace_e::host>(table);
+  std::vector<int> hits(n, 0);
+  bool ok = table.size() == n && table.overflow_count() == 0;
+  for (int i = 0; i != n; ++i) {
+    auto no = tv.query(keys[i]);
+    ok = ok && no >= 0 && no < n && table._activeKeys[no] == keys[i];
+    if (no >= 0 && no < n) ++hits[no];
+  }
+  for (int i = 0; i != n; ++i) ok = ok && hits[i] == 1;
+  check(ok, name, "concurrent insert");
+}
+
+/// duplicated keys in one batch share the index of a single insertion
+template <typename Table, typename Policy>
+void test_insert_bulk(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  const int n = 6000, numDistinct = 1500;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i) {
+    const int k = (i * 7) % numDistinct;
+    for (int d = 0; d != Table::dim; ++d) keys[i][d] = (k - numDistinct / 2) * (d + 1);
+  }
+
+  Table table{(std::size_t)numDistinct};
+  table.reset(pol, true);
+  auto ids = table.insert_bulk(pol, keys);
+  auto tv = proxy<execspace_e::host>(table);
+  bool ok = table.size() == numDistinct && table.overflow_count() == 0;
+  for (int i = 0; i != n; ++i)
+    ok = ok && ids[i] >= 0 && ids[i] == tv.query(keys[i]) && table._activeKeys[ids[i]] == keys[i];
+  /// a second batch of known keys leaves the table untouched
+  auto again = table.insert_bulk(pol, keys);
+  ok = ok && table.size() == numDistinct;
+  for (int i = 0; i != n; ++i) ok = ok && again[i] == ids[i];
+  check(ok, name, "insert_bulk deduplication");
+}
+
+/// a table too small for its keys counts the overflow, and insert_or_grow rehashes until they fit
+template <typename Table, typename Policy> void test_overflow(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  constexpr auto sentinel = Table::sentinel_v;
+  const int n = 3000;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i)
+    for (int d = 0; d != Table::dim; ++d) keys[i][d] = i * 3 + d - 500;
+
+  Table table{4};
+  table.reset(pol, true);
+  table.insert_bulk(pol, keys);
+  check(table.size() <= table._tableSize && table.overflow_count() > 0, name,
+        "overflow bookkeeping");
+  auto tv = proxy<execspace_e::host>(table);
+  int numFound = 0, missing = -1;
+  for (int i = 0; i != n; ++i) {
+    auto no = tv.query(keys[i]);
+    if (no >= 0)
+      numFound += table._activeKeys[no] == keys[i];
+    else if (missing < 0)
+      missing = i;
+  }
+  check(numFound == (int)table.size(), name, "keys accepted before overflowing");
+  /// an overflowed insertion is counted again
+  const auto numOverflowed = table.overflow_count();
+  check(tv.insert(keys[missing]) == sentinel && table.overflow_count() == numOverflowed + 1, name,
+        "repeated overflow");
+
+  auto ids = table.insert_or_grow(pol, keys);
+  bool ok = table.size() == n;
+  for (int i = 0; i != n; ++i) ok = ok && ids[i] >= 0 && table._activeKeys[ids[i]] == keys[i];
+  check(ok, name, "insert_or_grow");
+}
+
+/// dense coordinate lattices, e.g. the block ids of a level set, fit a table sized for them
+template <typename Table, typename Policy>
+void test_dense_lattice(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  const int extent = 64, n = extent * extent * extent;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i)
+    keys[i] = key_t{i / extent / extent, i / extent % extent, i % extent};
+
+  Table table{(std::size_t)n};
+  table.reset(pol, true);
+  auto ids = table.insert_bulk(pol, keys);
+  bool ok = table.size() == n && table.overflow_count() == 0;
+  for (int i = 0; i != n; ++i) ok = ok && ids[i] >= 0;
+  check(ok, name, "dense lattice insertion");
+}
+
+/// bucketed tables hold their expected entries at 80-90% load
+template <typename Table, typename Policy>
+void test_high_load(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  const int n = 7000;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i)
+    for (int d = 0; d != Table::dim; ++d) keys[i][d] = d ? (i * 2654435761u >> d) % 100003 : i;
+
+  Table table{(std::size_t)n};
+  table.reset(pol, true);
+  auto ids = table.insert_bulk(pol, keys);
+  auto tv = proxy<execspace_e::host>(table);
+  bool ok = table._tableSize < n * 5 / 4 && table.overflow_count() == 0;
+  for (int i = 0; i != n; ++i) ok = ok && ids[i] >= 0 && tv.query(keys[i]) == ids[i];
+  check(ok, name, "bucketed high load");
+}
+
+/// erased keys stop being found until reinserted, and stay erased through compact and resize
+template <typename Table, typename Policy> void test_erase(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  using key_t = typename Table::key_t;
+  const int n = 3000;
+  Vector<key_t> keys{(std::size_t)n};
+  for (int i = 0; i != n; ++i)
+    for (int d = 0; d != Table::dim; ++d) keys[i][d] = i * 3 + d - 500;
+  /// every third key is erased, every sixth one reinserted afterwards
+  auto alive = [](int i) { return i % 3 != 0 || i % 6 == 0; };
+  auto erase_some = [&keys, n](Table &table) {
+    auto tv = proxy<execspace_e::host>(table);
+    bool ok = true;
+    for (int i = 0; i < n; i += 3) ok = ok && tv.erase(keys[i]);
+    for (int i = 0; i < n; i += 3) ok = ok && !tv.erase(keys[i]);
+    for (int i = 0; i != n; ++i) ok = ok && (tv.query(keys[i]) < 0) == (i % 3 == 0);
+    for (int i = 0; i < n; i += 6) tv.insert(keys[i]);
+    return ok;
+  };
+  auto check_alive = [&](Table &table, std::string_view what) {
+    auto tv = proxy<execspace_e::host>(table);
+    bool ok = true;
+    for (int i = 0; i != n; ++i) {
+      auto no = tv.query(keys[i]);
+      ok = ok && alive(i) == (no >= 0);
+      if (alive(i)) ok = ok && table._activeKeys[no] == keys[i];
+    }
+    check(ok, name, what);
+  };
+
+  {
+    Table table{(std::size_t)n};
+    table.reset(pol, true);
+    auto ids = table.insert_bulk(pol, keys);
+    check(erase_some(table), name, "erase");
+    auto remap = table.compact(pol);
+    check_alive(table, "compact");
+    auto tv = proxy<execspace_e::host>(table);
+    bool ok = table.size() == n - n / 6;
+    for (int i = 0; i != n; ++i)
+      if (i % 3 != 0) ok = ok && remap[ids[i]] == tv.query(keys[i]);
+    check(ok, name, "compact remap");
+  }
+  /// live keys keep their indices through a rehash into a larger table
+  {
+    Table table{(std::size_t)n};
+    table.reset(pol, true);
+    auto ids = table.insert_bulk(pol, keys);
+    erase_some(table);
+    std::vector<typename Table::value_t> before(n);
+    auto tv = proxy<execspace_e::host>(table);
+    for (int i = 0; i != n; ++i) before[i] = tv.query(keys[i]);
+    table.resize(pol, (std::size_t)n * 4);
+    check_alive(table, "erase then resize");
+    tv = proxy<execspace_e::host>(table);
+    bool ok = true;
+    for (int i = 0; i != n; ++i) ok = ok && tv.query(keys[i]) == before[i];
+    for (int i = 1; i < n; i += 3) ok = ok && before[i] == ids[i];
+    check(ok, name, "indices kept through resize");
+
+    table.preserve(pol, (std::size_t)n * 16);
+    check_alive(table, "erase then preserve");
+  }
+}
+
+/// keys differing only beyond the bits a packed axis could hold stay distinct
+static void test_key_range() {
+  using namespace zs;
+  using Table = HashTable<i32, 3, int>;
+  static_assert(!Table::packed_key_v, "i32 dim-3 keys do not fit in a machine word!");
+  Table table{16};
+  table.reset(seq_exec(), true);
+  auto tv = proxy<execspace_e::host>(table);
+  const auto a = tv.insert(vec<i32, 3>{0, 0, 0});
+  const auto b = tv.insert(vec<i32, 3>{1 << 21, 0, 0});
+  const auto c = tv.insert(vec<i32, 3>{0, -(1 << 22), 1 << 30});
+  check(a >= 0 && b >= 0 && c >= 0 && a != b && b != c && a != c && table.size() == 3,
+        "wide keys stay distinct");
+
+  /// a partially packed word leaves its sign-extended all-ones pattern to the sentinel
+  using NarrowTable = HashTable<i8, 1, int>;
+  NarrowTable narrow{16};
+  narrow.reset(seq_exec(), true);
+  auto nv = proxy<execspace_e::host>(narrow);
+  const auto m = nv.insert(vec<i8, 1>{(i8)-1});
+  check(m >= 0 && nv.query(vec<i8, 1>{(i8)-1}) == m && narrow.size() == 1,
+        "narrow key next to the sentinel");
+}
+
+template <typename Policy> void test_policy(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  test_concurrent_insert<HashTable<i32, 2, int>>(pol, name);
+  test_concurrent_insert<HashTable<i16, 3, int>>(pol, name);
+  test_concurrent_insert<HashTable<i32, 3, int>>(pol, name);
+  test_insert_bulk<HashTable<i32, 2, int>>(pol, name);
+  test_insert_bulk<HashTable<i64, 1, i64>>(pol, name);
+  test_insert_bulk<HashTable<i32, 3, int>>(pol, name);
+  test_overflow<HashTable<i32, 3, int>>(pol, name);
+  test_overflow<HashTable<i64, 2, i64>>(pol, name);
+  test_dense_lattice<HashTable<i32, 3, int>>(pol, name);
+  test_erase<HashTable<i32, 3, int>>(pol, name);
+  test_erase<HashTable<i64, 2, i64>>(pol, name);
+
+  using BucketedTable = HashTable<i32, 2, int, ZSPmrAllocator<>, hash_layout_e::bucketed>;
+  using LockedBucketedTable = HashTable<i32, 3, int, ZSPmrAllocator<>, hash_layout_e::bucketed>;
+  test_insert_bulk<BucketedTable>(pol, name);
+  test_overflow<LockedBucketedTable>(pol, name);
+  test_dense_lattice<LockedBucketedTable>(pol, name);
+  test_high_load<BucketedTable>(pol, name);
+  test_high_load<LockedBucketedTable>(pol, name);
+  test_erase<LockedBucketedTable>(pol, name);
+}
+
+int main() {
+  using namespace zs;
+  test_key_range();
+  test_policy(seq_exec(), "seq");
+#if ZS_ENABLE_OPENMP
+  test_policy(omp_exec().threads(8), "omp");
+#endif
+  return report_checks();
+}
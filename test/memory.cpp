@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "check.hpp"
+#include "zensim/container/Vector.hpp"
+#include "zensim/memory/Allocator.h"
+#include "zensim/memory/MemOps.hpp"
+#include "zensim/resource/Resource.h"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+#if defined(ZS_PLATFORM_LINUX)
+#  include <sched.h>
+#endif
+
+/// writes i to every element i and reads it back
+static bool fill_and_check(zs::Vector<int> &vals) {
+  for (int i = 0; i != (int)vals.size(); ++i) vals[i] = i;
+  bool ok = true;
+  for (int i = 0; i != (int)vals.size(); ++i) ok = ok && vals[i] == i;
+  return ok;
+}
+
+/// size classes cover every request with at most 25% waste, freed blocks are reused
+static void test_pool() {
+  using namespace zs;
+  using pool_t = host_memory_pool;
+  bool ok = true;
+  for (std::size_t bytes = 1; bytes <= ((std::size_t)1 << 24); bytes = bytes * 5 / 4 + 1) {
+    const auto cls = pool_t::size_class(bytes);
+    const auto classBytes = pool_t::class_bytes(cls);
+    ok = ok && cls < pool_t::num_size_classes && classBytes >= bytes
+         && (bytes <= 256 || classBytes <= bytes + bytes / 4)
+         && pool_t::size_class(classBytes) == cls;
+  }
+  check(ok, "pool size classes");
+
+  auto &pool = pool_t::instance();
+  void *p = pool.allocate(1000, 8);
+  pool.deallocate(p, 1000, 8);
+  void *q = pool.allocate(1001, 16);  // same size class
+  check(q == p && (std::uintptr_t)q % pool_t::block_alignment == 0, "pool block reuse");
+  pool.deallocate(q, 1001, 16);
+  pool.release();
+  check(pool.cached_bytes() == 0, "pool release");
+
+  Vector<int> vals{get_memory_source(memsrc_e::host, -1, "POOL"), (std::size_t)10000};
+  ok = fill_and_check(vals);
+  vals.resize(50000);
+  check(ok && fill_and_check(vals), "pooled Vector");
+}
+
+#ifdef ZS_PLATFORM_UNIX
+/// huge page ranges start on a huge page boundary, and their bytes are accounted per backing
+static void test_huge_page() {
+  using namespace zs;
+  using resource_t = huge_page_memory_resource<host_mem_tag>;
+  constexpr auto pageBytes = resource_t::s_huge_page_bytes;
+  resource_t res{};
+  const std::size_t bytes = pageBytes * 2 + 1000;
+  auto p = (char *)res.allocate(bytes, 64);
+  const auto heldBytes
+      = res.explicit_huge_bytes() + res.transparent_huge_bytes() + res.regular_bytes();
+  bool ok = (std::uintptr_t)p % pageBytes == 0 && heldBytes == pageBytes * 3;
+  if (res.backing(p) == page_backing_e::explicit_huge)
+    ok = ok && res.explicit_huge_bytes() == heldBytes;
+  else if (res.backing(p) == page_backing_e::transparent_huge)
+    ok = ok && res.transparent_huge_bytes() == heldBytes;
+  for (std::size_t i = 0; i < bytes; i += 4096) p[i] = (char)i;
+  p[bytes - 1] = 1;
+  res.deallocate(p, bytes, 64);
+  ok = ok && res.explicit_huge_bytes() + res.transparent_huge_bytes() + res.regular_bytes() == 0;
+  check(ok, "huge page resource");
+
+  Vector<int> vals{get_memory_source(memsrc_e::host, -1, "HUGE_PAGE"), (std::size_t)1 << 20};
+  check(fill_and_check(vals) && (std::uintptr_t)vals.data() % pageBytes == 0,
+        "huge page Vector");
+}
+#endif
+
+#ifdef ZS_PLATFORM_UNIX
+/// numa placed Vectors work under every placement, and a parallel reset touches all of them
+static void test_numa() {
+  using namespace zs;
+  using resource_t = numa_memory_resource<host_mem_tag>;
+  const int numNodes = resource_t::num_nodes();
+  for (auto advice : {"NUMA_FIRST_TOUCH", "NUMA_INTERLEAVE", "NUMA_BIND"}) {
+    Vector<int> vals{get_memory_source(memsrc_e::host, 0, advice), (std::size_t)1 << 20};
+#  if ZS_ENABLE_OPENMP
+    vals.reset(omp_exec().threads(4), 0xff);
+#  else
+    vals.reset(seq_exec(), 0xff);
+#  endif
+    bool ok = numNodes >= 1;
+    for (int i = 0; i < (int)vals.size(); i += 1000) ok = ok && vals[i] == -1;
+    const int node = resource_t::node_of(vals.data());
+    ok = ok && node < numNodes && fill_and_check(vals);
+    check(ok, advice, "numa placed Vector");
+  }
+}
+#endif
+
+#if ZS_ENABLE_OPENMP && defined(ZS_PLATFORM_LINUX)
+/// the pool threads get one cpu each, whereas the calling thread keeps its mask
+static void test_pinning() {
+  using namespace zs;
+  if (omp_get_proc_bind() != omp_proc_bind_false) return;  // bound by the runtime instead
+  cpu_set_t before, after;
+  sched_getaffinity(0, sizeof(before), &before);
+  const int numThreads = 4;
+  bool ok = pin_omp_threads(numThreads, omp_thread_binding_e::compact);
+  sched_getaffinity(0, sizeof(after), &after);
+  ok = ok && CPU_EQUAL(&before, &after);
+  int numUnpinned = 0;
+#  pragma omp parallel num_threads(numThreads) reduction(+ : numUnpinned)
+  {
+    cpu_set_t set;
+    sched_getaffinity(0, sizeof(set), &set);
+    if (omp_get_thread_num() != 0 && CPU_COUNT(&set) != 1) ++numUnpinned;
+  }
+  check(ok && numUnpinned == 0, "pin_omp_threads");
+}
+#endif
+
+/// bulk transfers of every size class (single thread, split, streaming), from unaligned offsets
+static void test_transfers() {
+  using namespace zs;
+  for (std::size_t bytes : {(std::size_t)100, host_parallel_transfer_threshold_bytes * 3 + 13,
+                            host_streaming_threshold_bytes * 2 + 5}) {
+    std::vector<char> src(bytes + 8), dst(bytes + 8, 0), ref(bytes + 8, 0);
+    for (std::size_t i = 0; i != src.size(); ++i) src[i] = (char)(i * 7 + i / 4096);
+    std::memcpy(ref.data() + 3, src.data() + 5, bytes);
+    zs::copy(mem_host, dst.data() + 3, src.data() + 5, bytes);
+    check(dst == ref, "host copy");
+    std::memset(ref.data() + 1, 0x5a, bytes);
+    zs::memset(mem_host, dst.data() + 1, 0x5a, bytes);
+    check(dst == ref, "host memset");
+#if ZS_ENABLE_OPENMP
+    auto pol = omp_exec().threads(4);
+    std::fill(dst.begin(), dst.end(), 0);
+    std::fill(ref.begin(), ref.end(), 0);
+    std::memcpy(ref.data() + 3, src.data() + 5, bytes);
+    Resource::copy(pol, MemoryEntity{MemoryLocation{memsrc_e::host, -1}, dst.data() + 3},
+                   MemoryEntity{MemoryLocation{memsrc_e::host, -1}, src.data() + 5}, bytes);
+    check(dst == ref, "omp copy");
+    std::memset(ref.data() + 1, 0x5a, bytes);
+    Resource::memset(pol, MemoryEntity{MemoryLocation{memsrc_e::host, -1}, dst.data() + 1}, 0x5a,
+                     bytes);
+    check(dst == ref, "omp memset");
+    std::memset(ref.data() + 2, 0x11, bytes);
+    pol.first_touch(dst.data() + 2, bytes, 0x11);
+    check(dst == ref, "omp first_touch");
+#endif
+  }
+}
+
+int main() {
+  test_pool();
+  test_transfers();
+#ifdef ZS_PLATFORM_UNIX
+  test_huge_page();
+  test_numa();
+#endif
+#if ZS_ENABLE_OPENMP && defined(ZS_PLATFORM_LINUX)
+  /// last, since the pinning outlives the test
+  test_pinning();
+#endif
+  return report_checks();
+}
@@ -0,0 +1,71 @@
+#include <string_view>
+
+#include "check.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/geometry/Structurefree.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+using ParticlesT = zs::Particles<float, 3>;
+
+/// a vector and a scalar attribute plus the bins, all holding functions of the particle index
+static ParticlesT make_particles(int n) {
+  using namespace zs;
+  ParticlesT particles{(std::size_t)n};
+  particles.addAttr("m", attrib_e::scalar);
+  particles.particleBins = TileVector<float, 32>{{{"m", 1}}, (std::size_t)n};
+  auto &x = particles.attrVector("x");
+  auto &m = particles.attrScalar("m");
+  auto bins = proxy<execspace_e::host>({"m"}, particles.particleBins);
+  for (int i = 0; i != n; ++i) {
+    x[i] = vec<float, 3>{i * 1.f, i * 2.f, i * 3.f};
+    m[i] = i;
+    bins("m", i) = i;
+  }
+  return particles;
+}
+/// whether particle i holds the values initially given to particle src(i)
+template <typename F> static bool holds(ParticlesT &particles, int n, F &&src) {
+  using namespace zs;
+  const auto &x = particles.attrVector("x");
+  const auto &m = particles.attrScalar("m");
+  auto bins = proxy<execspace_e::host>({"m"}, particles.particleBins);
+  bool ok = (int)particles.size() == n && (int)particles.particleBins.size() == n;
+  for (int i = 0; i != n; ++i) {
+    const float j = src(i);
+    ok = ok && x[i][0] == j && x[i][2] == j * 3.f && m[i] == j && bins("m", i) == j;
+  }
+  return ok;
+}
+
+template <typename Policy> void test_permute(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  const int n = 1003;
+  Vector<int> order{(std::size_t)n};
+  for (int i = 0; i != n; ++i) order[i] = (i * 7 + 5) % n;
+  auto particles = make_particles(n);
+  particles.permute(pol, order);
+  check(holds(particles, n, [&order](int i) { return order[i]; }), name, "Particles::permute");
+}
+
+/// the attributes and the bins are compacted by the same marks, the survivors keep their order
+template <typename Policy> void test_erase_if(Policy &&pol, std::string_view name) {
+  const int n = 1003;
+  auto particles = make_particles(n);
+  auto e = particles.erase_if(pol, [](std::size_t i) { return i % 3 == 0; });
+  auto kept_index = [](int i) { return i / 2 * 3 + 1 + i % 2; };
+  check(e == (n + 2) / 3 && holds(particles, n - (int)e, kept_index), name,
+        "Particles::erase_if");
+}
+
+int main() {
+  using namespace zs;
+  test_permute(seq_exec(), "seq");
+  test_erase_if(seq_exec(), "seq");
+#if ZS_ENABLE_OPENMP
+  test_permute(omp_exec().threads(8), "omp");
+  test_erase_if(omp_exec().threads(8), "omp");
+#endif
+  return report_checks();
+}
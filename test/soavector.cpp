@@ -0,0 +1,50 @@
+#include <cstdint>
+
+#include "check.hpp"
+#include "zensim/container/SoAVector.hpp"
+
+/// every channel is an aligned contiguous column, which survives growth and cloning
+int main() {
+  using namespace zs;
+  using SoA = SoAVector<float>;
+  const int n = 100;
+  SoA soa{{{"x", 3}, {"m", 1}}, (std::size_t)n};
+  bool ok = soa.numChannels() == 4 && soa.capacity() >= n && soa.getChannelOffset("m") == 3;
+  for (int c = 0; c != 4; ++c)
+    ok = ok && (std::uintptr_t)soa.column(c) % SoA::column_alignment == 0
+         && soa.column(c) == soa.data() + c * soa.capacity();
+  check(ok, "SoAVector column layout");
+
+  auto write = [](SoA &vec, int begin, int end) {
+    auto sv = proxy<execspace_e::host>({"x", "m"}, vec);
+    for (int i = begin; i != end; ++i) {
+      for (int d = 0; d != 3; ++d) sv("x", d, i) = i * 3 + d;
+      sv("m", i) = -i;
+    }
+  };
+  auto holds = [](const SoA &vec, int end) {
+    auto sv = proxy<execspace_e::host>({"x", "m"}, vec);
+    auto uv = proxy<execspace_e::host>(vec);
+    bool ok = vec.size() >= (std::size_t)end;
+    for (int i = 0; i != end; ++i) {
+      auto x = sv.pack<3>("x", i);
+      ok = ok && x[0] == i * 3 && x[2] == i * 3 + 2 && sv("m", i) == -i;
+      ok = ok && uv.column(1)[i] == i * 3 + 1 && uv(3, i) == -i;
+    }
+    return ok;
+  };
+  write(soa, 0, n);
+  check(holds(soa, n), "SoAVector named access");
+
+  /// growing past the capacity relocates the columns to the new stride
+  soa.resize(n * 5);
+  write(soa, n, n * 5);
+  ok = holds(soa, n * 5) && soa.size() == n * 5;
+  for (int c = 0; c != 4; ++c)
+    ok = ok && (std::uintptr_t)soa.column(c) % SoA::column_alignment == 0;
+  check(ok, "SoAVector resize");
+
+  auto copy = soa.clone(soa.memoryLocation());
+  check(holds(copy, n * 5) && copy.data() != soa.data(), "SoAVector clone");
+  return report_checks();
+}
@@ -0,0 +1,102 @@
+#include "check.hpp"
+#include "zensim/container/Vector.hpp"
+#include "zensim/resource/Resource.h"
+#if ZS_ENABLE_OPENMP
+#  include <omp.h>
+#endif
+
+/// counters, breakdowns and the largest live allocations as allocations come and go
+static void test_counters() {
+  using namespace zs;
+  const auto before = Resource::telemetry().total;
+  {
+    Vector<double> a{1000};
+    Vector<int> b{get_memory_source(memsrc_e::host, -1, "POOL"), 500};
+    const auto t = Resource::telemetry(1);
+    check(t.total.liveBytes == before.liveBytes + 10000
+              && t.total.liveCount == before.liveCount + 2
+              && t.total.totalCount == before.totalCount + 2
+              && t.total.peakBytes >= t.total.liveBytes,
+          "counters of live allocations");
+    check(t.byAllocator.count("pooled_memory_resource")
+              && t.byAllocator.at("pooled_memory_resource").liveBytes >= 2000,
+          "allocator breakdown");
+#if ZS_ENABLE_ALLOCATION_RECORDS
+    check(t.largest.size() == 1 && t.largest[0].first == a.data(), "largest live allocations");
+#endif
+  }
+  auto t = Resource::telemetry();
+  check(t.total.liveBytes == before.liveBytes && t.total.liveCount == before.liveCount
+            && t.total.totalCount == before.totalCount + 2,
+        "counters after deallocation");
+
+#if ZS_ENABLE_ALLOCATION_RECORDS
+  {
+    AllocationSite site{};
+    Vector<float> c{100};
+    t = Resource::telemetry();
+    check(t.bySite.size() == 1 && t.bySite.begin()->second.liveBytes == 400,
+          "call site breakdown");
+  }
+#endif
+}
+
+/// allocations and frees from many threads at once land in different registry shards, the
+/// merged counters still balance
+static void test_concurrent() {
+#if ZS_ENABLE_OPENMP
+  using namespace zs;
+  const auto before = Resource::telemetry().total;
+  const int numThreads = 8, numRounds = 200;
+#  pragma omp parallel for num_threads(numThreads)
+  for (int t = 0; t < numThreads; ++t)
+    for (int r = 0; r != numRounds; ++r) {
+      Vector<int> v{(std::size_t)(t + 1) * 16};
+      v[0] = r;
+    }
+  const auto after = Resource::telemetry().total;
+  check(after.liveBytes == before.liveBytes && after.liveCount == before.liveCount
+            && after.totalCount == before.totalCount + numThreads * numRounds,
+        "counters of concurrent allocations");
+#endif
+}
+
+/// disabling zeroes the counters in place, frees of allocations made meanwhile go uncounted
+static void test_disable() {
+  using namespace zs;
+  Vector<float> d{100};
+  Resource::enable_telemetry(false);
+  auto t = Resource::telemetry();
+  check(!Resource::telemetry_enabled() && t.total.liveBytes == 0 && t.total.totalCount == 0
+            && t.byTag.empty(),
+        "counters after disabling");
+#if ZS_ENABLE_ALLOCATION_RECORDS
+  Resource::enable_telemetry();
+  d = Vector<float>{};
+  t = Resource::telemetry();
+  check(t.total.liveBytes == 0 && t.total.liveCount == 0, "free of an unrecorded allocation");
+#else
+  /// without records the frees of earlier allocations could not be told apart
+  bool refused = false;
+  try {
+    Resource::enable_telemetry();
+  } catch (const std::runtime_error &) {
+    refused = true;
+  }
+  check(refused && !Resource::telemetry_enabled(), "enabling after startup without records");
+#endif
+}
+
+/// run with ZS_ALLOCATION_TELEMETRY set, since without allocation records telemetry can only be
+/// enabled at startup
+int main() {
+  using namespace zs;
+  if (!Resource::telemetry_enabled()) {
+    fmt::print("allocation telemetry is off, ZS_ALLOCATION_TELEMETRY is not set\n");
+    return 1;
+  }
+  test_counters();
+  test_concurrent();
+  test_disable();  // last, since it turns telemetry off
+  return report_checks();
+}
@@ -0,0 +1,134 @@
+#include <string_view>
+
+#include "check.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+struct pos_t {
+  static constexpr const char *name = "x";
+};
+struct mass_t {
+  static constexpr const char *name = "m";
+};
+
+static void test_schema() {
+  using namespace zs;
+  using schema_t = TileSchema<TileProperty<mass_t, 1>, TileProperty<pos_t, 3>>;
+  static_assert(schema_t::num_channels == 4, "schema channel count error!");
+  static_assert(schema_t::property_offset<pos_t>() == 1, "schema property offset error!");
+
+  const int n = 70;
+  TileVector<float, 32> tiles{schema_t::get_property_tags(), (std::size_t)n};
+  auto sv = proxy<execspace_e::host, schema_t>(tiles);
+  for (int i = 0; i != n; ++i) {
+    sv(wrapt_v<mass_t>, i) = i;
+    for (int d = 0; d != 3; ++d) sv(wrapt_v<pos_t>, d, i) = i * 3 + d;
+  }
+  /// the property-name views, including an unnamed one through {}, see the same channels
+  auto nv = proxy<execspace_e::host>({"x", "m"}, tiles);
+  auto uv = proxy<execspace_e::host>({}, tiles);
+  const auto &ctiles = tiles;
+  auto cv = proxy<execspace_e::host, schema_t>(ctiles);
+  bool ok = true;
+  for (int i = 0; i != n; ++i) {
+    ok = ok && nv("m", i) == i && uv(0, i) == i;
+    auto x = cv.pack<3>(wrapt_v<pos_t>, i);
+    for (int d = 0; d != 3; ++d) ok = ok && nv("x", d, i) == i * 3 + d && x[d] == i * 3 + d;
+  }
+  check(ok, "TileSchema view");
+
+  bool thrown = false;
+  TileVector<float, 32> mismatched{{{"x", 3}, {"m", 1}}, (std::size_t)n};
+  try {
+    (void)proxy<execspace_e::host, schema_t>(mismatched);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  check(thrown, "TileSchema layout mismatch");
+}
+
+/// lane-wise tile kernels see the same channels as the element accessors
+template <typename Policy> void test_tiles(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  const int n = 1000;  // the last tile is partially filled
+  TileVector<float, 32> tiles{{{"x", 3}, {"m", 1}}, (std::size_t)n};
+  auto hv = proxy<execspace_e::host>({"x", "m"}, tiles);
+  for (int i = 0; i != n; ++i) {
+    for (int d = 0; d != 3; ++d) hv("x", d, i) = i * 3 + d;
+    hv("m", i) = i;
+  }
+  for_each_tile(pol, proxy<execspace_e::host>({"x", "m"}, tiles), [](auto tileid, auto tile) {
+    auto m = tile.lane("m");
+    for (int l = 0; l != 32; ++l) m[l] += tileid;
+    /// x.y <- x.x + x.z, a whole lane at a time
+    auto x = tile.load(0), z = tile.load(2);
+    tile.store(1, x + z);
+  });
+  bool ok = true;
+  for (int i = 0; i != n; ++i)
+    ok = ok && hv("m", i) == i + i / 32 && hv("x", 1, i) == i * 6 + 2
+         && hv("x", 2, i) == i * 3 + 2;
+  check(ok, name, "for_each_tile lanes");
+}
+
+/// every channel of element i moves along with it
+template <typename Policy> void test_permute(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  const int n = 1003;
+  Vector<int> order{(std::size_t)n};
+  for (int i = 0; i != n; ++i) order[i] = (i * 7 + 5) % n;
+  TileVector<float, 32> tiles{{{"x", 3}, {"m", 1}}, (std::size_t)n};
+  auto hv = proxy<execspace_e::host>({"x", "m"}, tiles);
+  for (int i = 0; i != n; ++i) {
+    for (int d = 0; d != 3; ++d) hv("x", d, i) = i * 3 + d;
+    hv("m", i) = i;
+  }
+  tiles.permute(pol, order);
+  auto pv = proxy<execspace_e::host>({"x", "m"}, tiles);
+  bool ok = tiles.size() == n;
+  for (int i = 0; i != n; ++i) {
+    for (int d = 0; d != 3; ++d) ok = ok && pv("x", d, i) == order[i] * 3 + d;
+    ok = ok && pv("m", i) == order[i];
+  }
+  check(ok, name, "TileVector::permute");
+}
+
+/// erase_if keeps the survivors in order, its predicate may read the tilevector itself
+template <typename Policy> void test_erase_if(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  constexpr auto space = remove_cvref_t<Policy>::exec_tag::value;
+  const int n = 1003;
+  TileVector<float, 32> tiles{{{"x", 3}, {"m", 1}}, (std::size_t)n};
+  auto hv = proxy<execspace_e::host>({"x", "m"}, tiles);
+  for (int i = 0; i != n; ++i) {
+    for (int d = 0; d != 3; ++d) hv("x", d, i) = i * 3 + d;
+    hv("m", i) = (i * 7 + 5) % n;
+  }
+  auto tv = proxy<space>({"m"}, tiles);
+  auto e = tiles.erase_if(pol, [tv](std::size_t i) { return (int)tv("m", i) % 3 == 0; });
+  auto ev = proxy<execspace_e::host>({"x", "m"}, tiles);
+  bool ok = e == (n + 2) / 3 && tiles.size() == n - e;
+  for (int i = 0, j = 0; i != n; ++i) {
+    const int v = (i * 7 + 5) % n;
+    if (v % 3 == 0) continue;
+    ok = ok && ev("m", j) == v && ev("x", 2, j) == i * 3 + 2;
+    ++j;
+  }
+  check(ok, name, "TileVector::erase_if");
+}
+
+int main() {
+  test_schema();
+  test_tiles(zs::seq_exec(), "seq");
+  test_permute(zs::seq_exec(), "seq");
+  test_erase_if(zs::seq_exec(), "seq");
+#if ZS_ENABLE_OPENMP
+  test_tiles(zs::omp_exec().threads(8), "omp");
+  test_permute(zs::omp_exec().threads(8), "omp");
+  test_erase_if(zs::omp_exec().threads(8), "omp");
+#endif
+  return report_checks();
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "check.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/container/Vector.hpp"
+#include "zensim/container/VectorAppender.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
+
+/// erase_if keeps the survivors in order
+template <typename Policy> void test_erase_if(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  const int n = 1003;
+  Vector<int> vals{(std::size_t)n};
+  for (int i = 0; i != n; ++i) vals[i] = i;
+  auto e = vals.erase_if(pol, [](const int &v) { return v % 3 == 0; });
+  bool ok = e == (n + 2) / 3 && vals.size() == n - e;
+  for (int i = 0; i != (int)vals.size(); ++i) ok = ok && vals[i] == i / 2 * 3 + 1 + i % 2;
+  check(ok, name, "Vector::erase_if");
+}
+
+template <typename AppenderView> struct AppendOdds {
+  using index_t = typename AppenderView::index_t;
+  void operator()(int i) {
+    if (i % 2) appender.atomic_push_back(i);
+    /// multiples of 10 come in pairs, filled through atomic_reserve
+    if (i % 10 == 0)
+      if (auto no = appender.atomic_reserve(2); no != AppenderView::sentinel_v)
+        appender[no] = appender[no + 1] = -i;
+  }
+  AppenderView appender;
+};
+
+/// pushes dropped for lack of room are retried after growing, the previous entries are kept
+template <typename Policy> void test_appender(Policy &&pol, std::string_view name) {
+  using namespace zs;
+  constexpr auto space = remove_cvref_t<Policy>::exec_tag::value;
+  const int n = 5000, numPrevious = 7;
+  Vector<int> vals{(std::size_t)numPrevious};
+  for (int i = 0; i != numPrevious; ++i) vals[i] = 100000 + i;
+  VectorAppender appender{vals, 16};
+  int numRounds = 0;
+  do {
+    ++numRounds;
+    pol(range(n), AppendOdds<RM_CVREF_T(proxy<space>(appender))>{proxy<space>(appender)});
+  } while (appender.grow_and_retry());
+
+  std::vector<int> expected, appended;
+  for (int i = numPrevious; i != (int)vals.size(); ++i) appended.push_back(vals[i]);
+  for (int i = 0; i != n; ++i) {
+    if (i % 2) expected.push_back(i);
+    if (i % 10 == 0) expected.insert(expected.end(), 2, -i);
+  }
+  std::sort(expected.begin(), expected.end());
+  std::sort(appended.begin(), appended.end());
+  bool ok = numRounds == 2 && appended == expected;
+  for (int i = 0; i != numPrevious; ++i) ok = ok && vals[i] == 100000 + i;
+  check(ok, name, "VectorAppender grow_and_retry");
+}
+
+/// vectors on a reserved virtual range grow by committing more of it, never moving
+static void test_virtual_growth() {
+  using namespace zs;
+  Vector<int, ZSPmrAllocator<true>> vals{(std::size_t)100};
+  for (int i = 0; i != 100; ++i) vals[i] = i;
+  const auto base = vals.data();
+  for (int i = 100; i != 300000; ++i) vals.push_back(i);
+  bool ok = vals.data() == base && vals.size() == 300000;
+  vals.resize(1 << 22);
+  ok = ok && vals.data() == base && vals.capacity() >= (1 << 22);
+  for (int i = 0; i != 300000; ++i) ok = ok && vals[i] == i;
+  check(ok, "virtual Vector growth in place");
+
+  TileVector<float, 32, ZSPmrAllocator<true>> tiles{{{"x", 3}}, (std::size_t)10};
+  const auto tileBase = tiles.data();
+  auto hv = proxy<execspace_e::host>({"x"}, tiles);
+  for (int i = 0; i != 10; ++i) hv("x", 2, i) = i;
+  tiles.resize(100000);
+  hv = proxy<execspace_e::host>({"x"}, tiles);
+  ok = tiles.data() == tileBase && tiles.size() == 100000;
+  for (int i = 0; i != 10; ++i) ok = ok && hv("x", 2, i) == i;
+  check(ok, "virtual TileVector growth in place");
+}
+
+template <typename Policy> void test_policy(Policy &&pol, std::string_view name) {
+  test_erase_if(pol, name);
+  test_appender(pol, name);
+}
+
+int main() {
+  using namespace zs;
+  test_virtual_growth();
+  test_policy(seq_exec(), "seq");
+#if ZS_ENABLE_OPENMP
+  test_policy(omp_exec().threads(8), "omp");
+#endif
+  return report_checks();
+}